@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "alist.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ALIST_X86 1
+#endif
+
+/* The SIMD kernels compare 32-bit lanes. */
+_Static_assert(sizeof(elem) == 4, "alist search kernels assume a 32-bit elem");
+
+/* Returns the index of the first x in v[0..n-1], or -1. */
+typedef int (*search_kernel)(const elem *v, int n, elem x);
+
+static int find_scalar(const elem* v, int n, elem x) {
+  for (int i = 0; i < n; i++) {
+    if (v[i] == x) return i;
+  }
+  return -1;
+}
+
+#ifdef ALIST_X86
+/* Four 4-lane compares per iteration; the lanes are only inspected one by
+ * one once the OR of all four says there is a hit. */
+__attribute__((target("sse2")))
+static int find_sse2(const elem* v, int n, elem x) {
+  __m128i key = _mm_set1_epi32(x);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), key);
+    __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i + 4)), key);
+    __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i + 8)), key);
+    __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i + 12)), key);
+    __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    if (_mm_movemask_epi8(any)) {
+      int m;
+      if ((m = _mm_movemask_ps(_mm_castsi128_ps(a)))) return i + __builtin_ctz(m);
+      if ((m = _mm_movemask_ps(_mm_castsi128_ps(b)))) return i + 4 + __builtin_ctz(m);
+      if ((m = _mm_movemask_ps(_mm_castsi128_ps(c)))) return i + 8 + __builtin_ctz(m);
+      m = _mm_movemask_ps(_mm_castsi128_ps(d));
+      return i + 12 + __builtin_ctz(m);
+    }
+  }
+  for (; i + 4 <= n; i += 4) {
+    __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), key);
+    int m = _mm_movemask_ps(_mm_castsi128_ps(a));
+    if (m) return i + __builtin_ctz(m);
+  }
+  for (; i < n; i++) {
+    if (v[i] == x) return i;
+  }
+  return -1;
+}
+
+/* Same structure as find_sse2 with 8-lane compares. */
+__attribute__((target("avx2")))
+static int find_avx2(const elem* v, int n, elem x) {
+  __m256i key = _mm256_set1_epi32(x);
+  int i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i)), key);
+    __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i + 8)), key);
+    __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i + 16)), key);
+    __m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i + 24)), key);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+    if (!_mm256_testz_si256(any, any)) {
+      int m;
+      if ((m = _mm256_movemask_ps(_mm256_castsi256_ps(a)))) return i + __builtin_ctz(m);
+      if ((m = _mm256_movemask_ps(_mm256_castsi256_ps(b)))) return i + 8 + __builtin_ctz(m);
+      if ((m = _mm256_movemask_ps(_mm256_castsi256_ps(c)))) return i + 16 + __builtin_ctz(m);
+      m = _mm256_movemask_ps(_mm256_castsi256_ps(d));
+      return i + 24 + __builtin_ctz(m);
+    }
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i)), key);
+    int m = _mm256_movemask_ps(_mm256_castsi256_ps(a));
+    if (m) return i + __builtin_ctz(m);
+  }
+  for (; i < n; i++) {
+    if (v[i] == x) return i;
+  }
+  return -1;
+}
+#endif
+
+static search_kernel kernel = NULL;
+
+static enum alist_kernel best_kernel() {
+#ifdef ALIST_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return ALIST_AVX2;
+  if (__builtin_cpu_supports("sse2")) return ALIST_SSE2;
+#endif
+  return ALIST_SCALAR;
+}
+
+enum alist_kernel alist_set_kernel(enum alist_kernel k) {
+  enum alist_kernel best = best_kernel();
+  if (k > best) k = best;
+  switch (k) {
+#ifdef ALIST_X86
+    case ALIST_AVX2: kernel = find_avx2; break;
+    case ALIST_SSE2: kernel = find_sse2; break;
+#endif
+    default: kernel = find_scalar; k = ALIST_SCALAR; break;
+  }
+  return k;
+}
+
+const char* alist_kernel_name(enum alist_kernel k) {
+  switch (k) {
+    case ALIST_AVX2: return "avx2";
+    case ALIST_SSE2: return "sse2";
+    default: return "scalar";
+  }
+}
+
+static void alist_reserve(alist_t* l, int need) {
+  if (need <= l->cap) return;
+  int cap = l->cap ? l->cap : 16;
+  while (cap < need) cap *= 2;
+  elem* values = realloc(l->values, (size_t)cap * sizeof(elem));
+  if (!values) {
+    fprintf(stderr, "Fatal: realloc failed in alist_reserve\n");
+    exit(1);
+  }
+  l->values = values;
+  l->cap = cap;
+}
+
+alist_t* alist_alloc() {
+  alist_t* l = malloc(sizeof(alist_t));
+  l->values = NULL;
+  l->length = 0;
+  l->cap = 0;
+  if (!kernel) alist_set_kernel(ALIST_AVX2);
+  return l;
+}
+
+void alist_free(alist_t* l) {
+  if (!l) return;
+  free(l->values);
+  free(l);
+}
+
+void alist_print(alist_t* l) {
+  if (!l) return;
+  for (int i = 0; i < l->length; i++) {
+    printf("%d ", l->values[i]);
+  }
+  printf("\n");
+}
+
+char* alistToString(alist_t* l) {
+  if (!l) return NULL;
+
+  /* at most 11 digits plus "->" per element, then "NULL" */
+  char* buffer = malloc((size_t)l->length * 13 + 5);
+  char* cursor = buffer;
+
+  for (int i = 0; i < l->length; i++) {
+    cursor += sprintf(cursor, "%d->", l->values[i]);
+  }
+
+  strcpy(cursor, "NULL");
+  return buffer;
+}
+
+int alist_length(alist_t* l) {
+  return l->length;
+}
+
+void alist_add_to_back(alist_t* l, elem value) {
+  alist_reserve(l, l->length + 1);
+  l->values[l->length++] = value;
+}
+
+void alist_add_to_front(alist_t* l, elem value) {
+  alist_add_at_index(l, value, 0);
+}
+
+void alist_add_at_index(alist_t* l, elem value, int index) {
+  if (!l) return;
+  if (index < 0) index = 0;
+  if (index > l->length) index = l->length;
+
+  alist_reserve(l, l->length + 1);
+  memmove(l->values + index + 1, l->values + index,
+          (size_t)(l->length - index) * sizeof(elem));
+  l->values[index] = value;
+  l->length++;
+}
+
+elem alist_remove_from_back(alist_t* l) {
+  if (!l || l->length == 0) return -1;
+  return l->values[--l->length];
+}
+
+elem alist_remove_from_front(alist_t* l) {
+  if (!l || l->length == 0) return -1;
+  return alist_remove_at_index(l, 0);
+}
+
+elem alist_remove_at_index(alist_t* l, int index) {
+  if (!l || l->length == 0) return -1;
+  if (index < 0) index = 0;
+  if (index >= l->length) return -1;
+
+  elem val = l->values[index];
+  l->length--;
+  memmove(l->values + index, l->values + index + 1,
+          (size_t)(l->length - index) * sizeof(elem));
+  return val;
+}
+
+bool alist_is_in(alist_t* l, elem value) {
+  return alist_get_index_of(l, value) != -1;
+}
+
+elem alist_get_elem_at(alist_t* l, int index) {
+  if (!l || index < 0 || index >= l->length) return -1;
+  return l->values[index];
+}
+
+int alist_get_index_of(alist_t* l, elem value) {
+  return kernel(l->values, l->length, value);
+}
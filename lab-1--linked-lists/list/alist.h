@@ -0,0 +1,57 @@
+// list/alist.h
+//
+// Interface definition for the array list. It offers the same operations as
+// list.h with the same index and error semantics, but keeps the elements in
+// one contiguous array so that list_is_in / list_get_index_of can run as
+// SIMD compare-and-movemask scans.
+//
+// <Author>
+
+#ifndef ALIST_H
+#define ALIST_H
+
+#include <stdbool.h>
+#include "list.h"
+
+/* Defines the array list. values[0..length-1] hold the elements in list
+ * order; cap is the allocated size of values. */
+struct alist {
+	elem *values;
+	int length;
+	int cap;
+};
+typedef struct alist alist_t;
+
+/* Search kernels, from slowest to fastest. The fastest kernel the CPU
+ * supports is picked on first use (CPUID via __builtin_cpu_supports). */
+enum alist_kernel {
+	ALIST_SCALAR,
+	ALIST_SSE2,
+	ALIST_AVX2
+};
+
+/* Forces a kernel, clamped to what the CPU supports; returns the one in use. */
+enum alist_kernel alist_set_kernel(enum alist_kernel k);
+const char *alist_kernel_name(enum alist_kernel k);
+
+alist_t *alist_alloc();
+void alist_free(alist_t *l);
+
+void alist_print(alist_t *l);
+char* alistToString(alist_t *l);
+
+int alist_length(alist_t *l);
+
+void alist_add_to_back(alist_t *l, elem value);
+void alist_add_to_front(alist_t *l, elem value);
+void alist_add_at_index(alist_t *l, elem value, int index);
+
+elem alist_remove_from_back(alist_t *l);
+elem alist_remove_from_front(alist_t *l);
+elem alist_remove_at_index(alist_t *l, int index);
+
+bool alist_is_in(alist_t *l, elem value);
+elem alist_get_elem_at(alist_t *l, int index);
+int alist_get_index_of(alist_t *l, elem value);
+
+#endif // ALIST_H
@@ -0,0 +1,149 @@
+// list/bench_lfq.c
+//
+// Multi-threaded stress test and throughput benchmark for lfqueue_t. Half the
+// threads produce, half consume. Each producer tags its values with its id
+// and a sequence number; consumers check that every producer's values come
+// out in order and that nothing is lost or duplicated. The same workload is
+// run on a list_t guarded by one mutex for comparison.
+//
+// usage: ./bench_lfq [ops_per_producer] [max_threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "list.h"
+#include "lfqueue.h"
+
+#define SEQ_BITS 24
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct shared {
+  bool locked;           /* which queue to use */
+  lfqueue_t* q;
+  list_t* l;
+  pthread_mutex_t lock;
+  int ops;               /* values per producer */
+  int producers;
+  long remaining;        /* values still to be consumed */
+  long checksum;
+  int errors;
+};
+
+struct worker {
+  struct shared* s;
+  int id;
+};
+
+static void push(struct shared* s, elem v) {
+  if (!s->locked) {
+    lfq_add_to_back(s->q, v);
+    return;
+  }
+  pthread_mutex_lock(&s->lock);
+  list_add_to_back(s->l, v);
+  pthread_mutex_unlock(&s->lock);
+}
+
+static bool pop(struct shared* s, elem* v) {
+  if (!s->locked) return lfq_try_remove_from_front(s->q, v);
+  pthread_mutex_lock(&s->lock);
+  bool ok = list_length(s->l) > 0;
+  if (ok) *v = list_remove_from_front(s->l);
+  pthread_mutex_unlock(&s->lock);
+  return ok;
+}
+
+static void* producer(void* arg) {
+  struct worker* w = arg;
+  for (int i = 0; i < w->s->ops; i++) {
+    push(w->s, (w->id << SEQ_BITS) | i);
+  }
+  return NULL;
+}
+
+static void* consumer(void* arg) {
+  struct shared* s = ((struct worker*)arg)->s;
+  int* last = malloc(s->producers * sizeof(int));
+  long sum = 0;
+  int errors = 0;
+  elem v;
+
+  for (int i = 0; i < s->producers; i++) last[i] = -1;
+  while (__atomic_load_n(&s->remaining, __ATOMIC_RELAXED) > 0) {
+    if (!pop(s, &v)) continue;
+    __atomic_fetch_sub(&s->remaining, 1, __ATOMIC_RELAXED);
+    int p = v >> SEQ_BITS, seq = v & ((1 << SEQ_BITS) - 1);
+    if (p >= s->producers || seq <= last[p]) errors++;
+    else last[p] = seq;
+    sum += v;
+  }
+  __atomic_fetch_add(&s->checksum, sum, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&s->errors, errors, __ATOMIC_RELAXED);
+  free(last);
+  return NULL;
+}
+
+static void run(bool locked, int threads, int ops) {
+  struct shared s;
+  int producers = threads / 2, consumers = threads - producers;
+  pthread_t tids[threads];
+  struct worker w[threads];
+  long expected = 0;
+
+  s.locked = locked;
+  s.q = locked ? NULL : lfq_alloc();
+  s.l = locked ? list_alloc() : NULL;
+  pthread_mutex_init(&s.lock, NULL);
+  s.ops = ops;
+  s.producers = producers;
+  s.remaining = (long)producers * ops;
+  s.checksum = 0;
+  s.errors = 0;
+  for (int p = 0; p < producers; p++)
+    for (int i = 0; i < ops; i++) expected += (p << SEQ_BITS) | i;
+
+  double t0 = now_sec();
+  for (int i = 0; i < threads; i++) {
+    w[i].s = &s;
+    w[i].id = i;
+    pthread_create(&tids[i], NULL, i < producers ? producer : consumer, &w[i]);
+  }
+  for (int i = 0; i < threads; i++) pthread_join(tids[i], NULL);
+  double t = now_sec() - t0;
+
+  /* every value is pushed once and popped once */
+  double ops_sec = 2.0 * producers * ops / t;
+  printf("%-8s threads=%-3d (%dp/%dc) %10.0f ops/sec  %s\n",
+         locked ? "mutex" : "lockfree", threads, producers, consumers, ops_sec,
+         s.errors == 0 && s.checksum == expected ? "ok" : "FAILED");
+  if (s.errors || s.checksum != expected) {
+    fprintf(stderr, "errors=%d checksum=%ld expected=%ld\n",
+            s.errors, s.checksum, expected);
+    exit(1);
+  }
+
+  if (locked) list_free(s.l);
+  else lfq_free(s.q);
+  pthread_mutex_destroy(&s.lock);
+}
+
+int main(int argc, char* argv[]) {
+  int ops = argc > 1 ? atoi(argv[1]) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 16;
+
+  if (ops >= (1 << SEQ_BITS)) ops = (1 << SEQ_BITS) - 1;
+  if (max_threads > LFQ_MAX_THREADS) max_threads = LFQ_MAX_THREADS;
+
+  for (int t = 2; t <= max_threads; t *= 2) {
+    run(false, t, ops);
+    run(true, t, ops);
+  }
+  return 0;
+}
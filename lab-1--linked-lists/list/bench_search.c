@@ -0,0 +1,54 @@
+// list/bench_search.c
+//
+// Times list_is_in / list_get_index_of style searches on n ints: the linked
+// list_t scan against the array list with each search kernel the CPU has.
+//
+// usage: ./bench_search [n] [queries]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "list.h"
+#include "alist.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 10000000;
+  int q = argc > 2 ? atoi(argv[2]) : 20;
+  list_t* l = list_alloc();
+  alist_t* a = alist_alloc();
+  double t0, base;
+  long sum = 0;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    list_add_to_back(l, i);
+    alist_add_to_back(a, i);
+  }
+
+  /* half the queries hit near the end, half miss entirely */
+  printf("n=%d, %d searches\n", n, q);
+  t0 = now_sec();
+  for (i = 0; i < q; i++) sum += list_get_index_of(l, i % 2 ? n - 1 - i : -1);
+  base = now_sec() - t0;
+  printf("%-14s %8.4f s   %6.2fx   (check %ld)\n", "linked", base, 1.0, sum);
+
+  for (int k = ALIST_SCALAR; k <= ALIST_AVX2; k++) {
+    if (alist_set_kernel(k) != (enum alist_kernel)k) continue;
+    sum = 0;
+    t0 = now_sec();
+    for (i = 0; i < q; i++) sum += alist_get_index_of(a, i % 2 ? n - 1 - i : -1);
+    double t = now_sec() - t0;
+    printf("array/%-8s %8.4f s   %6.2fx   (check %ld)\n",
+           alist_kernel_name(k), t, base / t, sum);
+  }
+
+  list_free(l);
+  alist_free(a);
+  return 0;
+}
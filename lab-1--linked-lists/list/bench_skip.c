@@ -0,0 +1,57 @@
+// list/bench_skip.c
+//
+// Random positional workloads (get, insert, remove at random indices) on the
+// indexable skip list at several sizes, with the linked list_t as baseline.
+// The linked list does far fewer operations since each one is O(index);
+// compare the per-operation times.
+//
+// usage: ./bench_skip [ops] [linked_ops] [n ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "list.h"
+#include "sklist.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define BENCH(prefix, type, label, n, q)                                    \
+  do {                                                                      \
+    type* l = prefix##_alloc();                                             \
+    double t0, t_get, t_ins, t_rem;                                         \
+    long sum = 0;                                                           \
+    int i;                                                                  \
+    for (i = 0; i < n; i++) prefix##_add_to_back(l, i);                     \
+    srand(7);                                                               \
+    t0 = now_sec();                                                         \
+    for (i = 0; i < q; i++) sum += prefix##_get_elem_at(l, rand() % n);     \
+    t_get = now_sec() - t0;                                                 \
+    t0 = now_sec();                                                         \
+    for (i = 0; i < q; i++) prefix##_add_at_index(l, i, rand() % n);       \
+    t_ins = now_sec() - t0;                                                 \
+    t0 = now_sec();                                                         \
+    for (i = 0; i < q; i++) sum += prefix##_remove_at_index(l, rand() % n); \
+    t_rem = now_sec() - t0;                                                 \
+    printf("%-8s n=%-9d ops=%-8d get %9.3f us  add_at %9.3f us  "         \
+           "remove_at %9.3f us  (check %ld)\n", label, n, q,                \
+           t_get / q * 1e6, t_ins / q * 1e6, t_rem / q * 1e6, sum);         \
+    prefix##_free(l);                                                       \
+  } while (0)
+
+int main(int argc, char* argv[]) {
+  int q = argc > 1 ? atoi(argv[1]) : 1000000;
+  int q_linked = argc > 2 ? atoi(argv[2]) : 200;
+  int default_sizes[] = {100000, 1000000, 10000000};
+  int nsizes = argc > 3 ? argc - 3 : 3;
+
+  for (int s = 0; s < nsizes; s++) {
+    int n = argc > 3 ? atoi(argv[3 + s]) : default_sizes[s];
+    BENCH(sklist, sklist_t, "skiplist", n, q);
+    BENCH(list, list_t, "linked", n, q_linked);
+  }
+  return 0;
+}
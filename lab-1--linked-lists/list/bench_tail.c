@@ -0,0 +1,90 @@
+// list/bench_tail.c
+//
+// Times back-inserts and length queries on list_t. The "walk" columns
+// re-create the old behaviour (find the tail / count nodes from l->head on
+// every call) so the before and after numbers come from the same binary.
+//
+// usage: ./bench_tail [n] [walk_n]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "list.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* old list_add_to_back: walk to the last node on every insert */
+static void walk_add_to_back(list_t* l, elem value) {
+  node_t* n = getNode(value);
+  if (!l->head) {
+    l->head = n;
+    return;
+  }
+  node_t* curr = l->head;
+  while (curr->next) {
+    curr = curr->next;
+  }
+  curr->next = n;
+}
+
+/* old list_length: count every node */
+static int walk_length(list_t* l) {
+  int count = 0;
+  node_t* curr = l->head;
+  while (curr) {
+    count++;
+    curr = curr->next;
+  }
+  return count;
+}
+
+static void run(int n, int walk) {
+  list_t* l = list_alloc();
+  double t0, t_add, t_len;
+  long sum = 0;
+  int i;
+
+  t0 = now_sec();
+  for (i = 0; i < n; i++) {
+    if (walk) walk_add_to_back(l, i);
+    else list_add_to_back(l, i);
+  }
+  t_add = now_sec() - t0;
+
+  t0 = now_sec();
+  for (i = 0; i < n; i++) {
+    sum += walk ? walk_length(l) : list_length(l);
+  }
+  t_len = now_sec() - t0;
+
+  printf("%-6s n=%-9d add_to_back %10.4f s   length %10.4f s   (check %ld)\n",
+         walk ? "walk" : "tail", n, t_add, t_len, sum / n);
+
+  if (!walk) {
+    list_free(l);
+    return;
+  }
+
+  /* the walk variant takes its nodes from getNode, so free them by hand */
+  node_t* curr = l->head;
+  while (curr) {
+    node_t* tmp = curr;
+    curr = curr->next;
+    free(tmp);
+  }
+  list_free(l);
+}
+
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int walk_n = argc > 2 ? atoi(argv[2]) : 20000;
+
+  run(walk_n, 1);
+  run(walk_n, 0);
+  run(n, 0);
+  return 0;
+}
@@ -0,0 +1,58 @@
+// list/bench_unrolled.c
+//
+// Compares the singly linked list_t against the unrolled ulist_t on the same
+// random positional and search workloads.
+//
+// usage: ./bench_unrolled [n] [queries]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "list.h"
+#include "ulist.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Both backends expose the same operations; the macro keeps the two timing
+ * loops identical apart from the prefix. */
+#define BENCH(prefix, type, label)                                       \
+  do {                                                                   \
+    type* l = prefix##_alloc();                                          \
+    double t0, t_build, t_get, t_find, t_ins, t_rem;                     \
+    long sum = 0;                                                        \
+    int i;                                                               \
+    t0 = now_sec();                                                      \
+    for (i = 0; i < n; i++) prefix##_add_to_back(l, i);                  \
+    t_build = now_sec() - t0;                                            \
+    srand(42);                                                           \
+    t0 = now_sec();                                                      \
+    for (i = 0; i < q; i++) sum += prefix##_get_elem_at(l, rand() % n);  \
+    t_get = now_sec() - t0;                                              \
+    t0 = now_sec();                                                      \
+    for (i = 0; i < q; i++) sum += prefix##_is_in(l, -1 - i);            \
+    t_find = now_sec() - t0;                                             \
+    t0 = now_sec();                                                      \
+    for (i = 0; i < q; i++) prefix##_add_at_index(l, i, rand() % n);    \
+    t_ins = now_sec() - t0;                                              \
+    t0 = now_sec();                                                      \
+    for (i = 0; i < q; i++) sum += prefix##_remove_at_index(l, rand() % n); \
+    t_rem = now_sec() - t0;                                              \
+    printf("%-8s build %8.4f s  get %8.4f s  is_in %8.4f s  "          \
+           "add_at %8.4f s  remove_at %8.4f s  (check %ld)\n",           \
+           label, t_build, t_get, t_find, t_ins, t_rem, sum);            \
+    prefix##_free(l);                                                    \
+  } while (0)
+
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int q = argc > 2 ? atoi(argv[2]) : 1000;
+
+  printf("n=%d, %d queries per operation\n", n, q);
+  BENCH(list, list_t, "linked");
+  BENCH(ulist, ulist_t, "unrolled");
+  return 0;
+}
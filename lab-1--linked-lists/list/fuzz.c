@@ -0,0 +1,516 @@
+// list/fuzz.c
+//
+// Randomized differential test and latency harness for every list backend.
+// Each backend runs the same random operation sequences as a plain array
+// model of the list.h semantics (out-of-range indices included). Every
+// result and the length are compared after each operation, and the whole
+// list is compared through its ToString every STRING_CHECK_EVERY ops and
+// at the end of each sequence.
+// Sequences grow for their first half and mostly shrink in the second, so
+// the empty-list edges are covered as well. The first mismatch is reported
+// with the seed that replays it.
+//
+// Each operation is also timed on its own, and a latency histogram per
+// backend and operation is printed as p50/p99/max in ns. The figures
+// include the clock_gettime overhead, which is printed first.
+//
+// usage: ./fuzz [sequences] [max_ops_per_sequence] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "list.h"
+#include "ulist.h"
+#include "alist.h"
+#include "sklist.h"
+#include "lfqueue.h"
+
+/* Element values are drawn from a small range so searches often hit. */
+#define VALUE_RANGE 64
+
+/* The whole list is compared through ToString once every this many ops. */
+#define STRING_CHECK_EVERY 64
+
+enum op {
+  OP_ADD_BACK,
+  OP_ADD_FRONT,
+  OP_ADD_AT,
+  OP_REMOVE_BACK,
+  OP_REMOVE_FRONT,
+  OP_REMOVE_AT,
+  OP_IS_IN,
+  OP_GET_AT,
+  OP_INDEX_OF,
+  OP_SORT,
+  OP_SPLIT_SPLICE,
+  NOPS
+};
+
+static const char* op_names[NOPS] = {
+  "add_to_back", "add_to_front", "add_at_index", "remove_from_back",
+  "remove_from_front", "remove_at_index", "is_in", "get_elem_at",
+  "get_index_of", "sort", "split+splice"
+};
+
+/* Operations of one backend on an opaque list. An operation left NULL is
+ * not supported by that backend and is never drawn for it. */
+struct backend {
+  const char* name;
+  bool (*setup)(void);  /* optional; returns false if it cannot run here */
+  void* (*alloc)(void);
+  void (*free)(void*);
+  char* (*to_string)(void*);
+  int (*length)(void*);
+  void (*add_to_back)(void*, elem);
+  void (*add_to_front)(void*, elem);
+  void (*add_at_index)(void*, elem, int);
+  elem (*remove_from_back)(void*);
+  elem (*remove_from_front)(void*);
+  elem (*remove_at_index)(void*, int);
+  bool (*is_in)(void*, elem);
+  elem (*get_elem_at)(void*, int);
+  int (*get_index_of)(void*, elem);
+  void (*sort)(void*);
+  void (*split_splice)(void*, int);
+};
+
+/* Generates the typed wrappers for a backend with the full list.h API. */
+#define LIST_WRAPPERS(prefix, type, tostr)                                      \
+  static void* prefix##_w_alloc(void) { return prefix##_alloc(); }              \
+  static void prefix##_w_free(void* l) { prefix##_free((type*)l); }             \
+  static char* prefix##_w_to_string(void* l) { return tostr((type*)l); }        \
+  static int prefix##_w_length(void* l) { return prefix##_length((type*)l); }   \
+  static void prefix##_w_add_to_back(void* l, elem v) {                         \
+    prefix##_add_to_back((type*)l, v);                                          \
+  }                                                                             \
+  static void prefix##_w_add_to_front(void* l, elem v) {                        \
+    prefix##_add_to_front((type*)l, v);                                         \
+  }                                                                             \
+  static void prefix##_w_add_at_index(void* l, elem v, int i) {                 \
+    prefix##_add_at_index((type*)l, v, i);                                      \
+  }                                                                             \
+  static elem prefix##_w_remove_from_back(void* l) {                            \
+    return prefix##_remove_from_back((type*)l);                                 \
+  }                                                                             \
+  static elem prefix##_w_remove_from_front(void* l) {                           \
+    return prefix##_remove_from_front((type*)l);                                \
+  }                                                                             \
+  static elem prefix##_w_remove_at_index(void* l, int i) {                      \
+    return prefix##_remove_at_index((type*)l, i);                               \
+  }                                                                             \
+  static bool prefix##_w_is_in(void* l, elem v) {                               \
+    return prefix##_is_in((type*)l, v);                                         \
+  }                                                                             \
+  static elem prefix##_w_get_elem_at(void* l, int i) {                          \
+    return prefix##_get_elem_at((type*)l, i);                                   \
+  }                                                                             \
+  static int prefix##_w_get_index_of(void* l, elem v) {                         \
+    return prefix##_get_index_of((type*)l, v);                                  \
+  }
+
+#define LIST_BACKEND(prefix, label, setup_fn, sort_fn, split_fn)               \
+  { label, setup_fn, prefix##_w_alloc, prefix##_w_free, prefix##_w_to_string,  \
+    prefix##_w_length, prefix##_w_add_to_back, prefix##_w_add_to_front,        \
+    prefix##_w_add_at_index, prefix##_w_remove_from_back,                      \
+    prefix##_w_remove_from_front, prefix##_w_remove_at_index,                  \
+    prefix##_w_is_in, prefix##_w_get_elem_at, prefix##_w_get_index_of,        \
+    sort_fn, split_fn }
+
+LIST_WRAPPERS(list, list_t, listToString)
+LIST_WRAPPERS(ulist, ulist_t, ulistToString)
+LIST_WRAPPERS(alist, alist_t, alistToString)
+LIST_WRAPPERS(sklist, sklist_t, sklistToString)
+
+static void list_w_sort(void* l) { list_sort((list_t*)l); }
+
+/* Splits at index and splices the suffix straight back, which must leave
+ * the list unchanged. */
+static void list_w_split_splice(void* l, int index) {
+  list_t* rest = list_split((list_t*)l, index);
+  list_splice((list_t*)l, rest);
+  list_free(rest);
+}
+
+static bool alist_setup_scalar(void) {
+  return alist_set_kernel(ALIST_SCALAR) == ALIST_SCALAR;
+}
+static bool alist_setup_sse2(void) {
+  return alist_set_kernel(ALIST_SSE2) == ALIST_SSE2;
+}
+static bool alist_setup_avx2(void) {
+  return alist_set_kernel(ALIST_AVX2) == ALIST_AVX2;
+}
+
+/* The lock-free queue only supports the FIFO operations; it is run single
+ * threaded here (bench_lfq covers concurrency) and drained at the end of
+ * each sequence instead of being compared through a string. */
+static void* lfq_w_alloc(void) { return lfq_alloc(); }
+static void lfq_w_free(void* q) { lfq_free((lfqueue_t*)q); }
+static void lfq_w_add_to_back(void* q, elem v) {
+  lfq_add_to_back((lfqueue_t*)q, v);
+}
+static elem lfq_w_remove_from_front(void* q) {
+  return lfq_remove_from_front((lfqueue_t*)q);
+}
+
+static struct backend backends[] = {
+  LIST_BACKEND(list, "list", NULL, list_w_sort, list_w_split_splice),
+  LIST_BACKEND(ulist, "ulist", NULL, NULL, NULL),
+  LIST_BACKEND(alist, "alist/scalar", alist_setup_scalar, NULL, NULL),
+  LIST_BACKEND(alist, "alist/sse2", alist_setup_sse2, NULL, NULL),
+  LIST_BACKEND(alist, "alist/avx2", alist_setup_avx2, NULL, NULL),
+  LIST_BACKEND(sklist, "sklist", NULL, NULL, NULL),
+  { "lfqueue", NULL, lfq_w_alloc, lfq_w_free, NULL, NULL, lfq_w_add_to_back,
+    NULL, NULL, NULL, lfq_w_remove_from_front, NULL, NULL, NULL, NULL, NULL,
+    NULL },
+};
+#define NBACKENDS ((int)(sizeof(backends) / sizeof(backends[0])))
+
+/* Reference model: values[0..n-1] in list order. */
+struct model {
+  elem* values;
+  int n;
+  int cap;
+};
+
+static void model_insert(struct model* m, elem value, int index) {
+  if (m->n == m->cap) {
+    m->cap = m->cap ? m->cap * 2 : 64;
+    m->values = realloc(m->values, m->cap * sizeof(elem));
+    if (!m->values) {
+      fprintf(stderr, "Fatal: realloc failed in model_insert\n");
+      exit(1);
+    }
+  }
+  if (index < 0) index = 0;
+  if (index > m->n) index = m->n;
+  memmove(m->values + index + 1, m->values + index,
+          (m->n - index) * sizeof(elem));
+  m->values[index] = value;
+  m->n++;
+}
+
+/* Same contract as list_remove_at_index: -1 if index is past the end. */
+static elem model_remove(struct model* m, int index) {
+  if (m->n == 0 || index >= m->n) return -1;
+  if (index < 0) index = 0;
+  elem v = m->values[index];
+  memmove(m->values + index, m->values + index + 1,
+          (m->n - index - 1) * sizeof(elem));
+  m->n--;
+  return v;
+}
+
+static int model_index_of(struct model* m, elem value) {
+  for (int i = 0; i < m->n; i++) {
+    if (m->values[i] == value) return i;
+  }
+  return -1;
+}
+
+static int cmp_elem(const void* a, const void* b) {
+  elem x = *(const elem*)a, y = *(const elem*)b;
+  return (x > y) - (x < y);
+}
+
+static char* model_to_string(struct model* m) {
+  char* buffer = malloc((size_t)m->n * 13 + 5);
+  char* cursor = buffer;
+  for (int i = 0; i < m->n; i++) cursor += sprintf(cursor, "%d->", m->values[i]);
+  strcpy(cursor, "NULL");
+  return buffer;
+}
+
+static uint64_t rng_state;
+
+static uint64_t rng_next() {
+  uint64_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return rng_state = x;
+}
+
+static int rng_range(int lo, int hi) {
+  return lo + (int)(rng_next() % (uint64_t)(hi - lo + 1));
+}
+
+/* Log-linear latency histogram: exact below HIST_SUB ns, then HIST_SUB
+ * buckets per power of two (about 6% resolution). */
+#define HIST_SUB_BITS 4
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS (64 * HIST_SUB)
+
+struct hist {
+  long count;
+  uint64_t max;
+  long buckets[HIST_BUCKETS];
+};
+
+static int hist_bucket(uint64_t ns) {
+  if (ns < HIST_SUB) return (int)ns;
+  int e = 63 - __builtin_clzll(ns);
+  int sub = (int)(ns >> (e - HIST_SUB_BITS)) & (HIST_SUB - 1);
+  return (e - HIST_SUB_BITS + 1) * HIST_SUB + sub;
+}
+
+static uint64_t hist_bucket_floor(int b) {
+  if (b < HIST_SUB) return b;
+  int e = b / HIST_SUB + HIST_SUB_BITS - 1;
+  return (uint64_t)(HIST_SUB + b % HIST_SUB) << (e - HIST_SUB_BITS);
+}
+
+static void hist_add(struct hist* h, uint64_t ns) {
+  h->buckets[hist_bucket(ns)]++;
+  h->count++;
+  if (ns > h->max) h->max = ns;
+}
+
+static uint64_t hist_percentile(struct hist* h, double p) {
+  long rank = (long)(p * h->count);
+  long seen = 0;
+  if (rank >= h->count) rank = h->count - 1;
+  for (int b = 0; b < HIST_BUCKETS; b++) {
+    seen += h->buckets[b];
+    if (seen > rank) return hist_bucket_floor(b);
+  }
+  return h->max;
+}
+
+static inline uint64_t now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static bool supported(struct backend* b, enum op op) {
+  switch (op) {
+    case OP_ADD_BACK: return b->add_to_back;
+    case OP_ADD_FRONT: return b->add_to_front;
+    case OP_ADD_AT: return b->add_at_index;
+    case OP_REMOVE_BACK: return b->remove_from_back;
+    case OP_REMOVE_FRONT: return b->remove_from_front;
+    case OP_REMOVE_AT: return b->remove_at_index;
+    case OP_IS_IN: return b->is_in;
+    case OP_GET_AT: return b->get_elem_at;
+    case OP_INDEX_OF: return b->get_index_of;
+    case OP_SORT: return b->sort;
+    case OP_SPLIT_SPLICE: return b->split_splice;
+    default: return false;
+  }
+}
+
+/* Draws an operation the backend supports. While growing, adds are three
+ * times as likely as removes; while shrinking it is the other way round.
+ * Sort is rare since it reorders everything. */
+static enum op pick_op(struct backend* b, bool growing) {
+  for (;;) {
+    int r = rng_range(0, 99);
+    enum op op;
+    if (r < 36) {
+      op = growing ? OP_ADD_BACK + r % 3 : OP_REMOVE_BACK + r % 3;
+    } else if (r < 48) {
+      op = growing ? OP_REMOVE_BACK + r % 3 : OP_ADD_BACK + r % 3;
+    } else if (r < 96) {
+      op = OP_IS_IN + r % 3;
+    } else if (r < 97) {
+      op = OP_SORT;
+    } else {
+      op = OP_SPLIT_SPLICE;
+    }
+    if (supported(b, op)) return op;
+  }
+}
+
+struct failure {
+  const char* what;
+  long expected;
+  long got;
+};
+
+/* Runs one sequence on a fresh list; returns false and fills *f on the
+ * first mismatch. */
+static bool run_sequence(struct backend* b, struct model* m, int nops,
+                         struct hist* hists, struct failure* f, int* at_op,
+                         enum op* at) {
+  void* l = b->alloc();
+  bool ok = true;
+  m->n = 0;
+
+  for (int i = 0; i < nops && ok; i++) {
+    enum op op = pick_op(b, i < nops / 2);
+    elem v = rng_range(0, VALUE_RANGE - 1);
+    int index = rng_range(-2, m->n + 2);
+    long expected = 0, got = 0;
+    uint64_t t0, t1;
+
+    *at_op = i;
+    *at = op;
+    switch (op) {
+      case OP_ADD_BACK:
+        t0 = now_ns(); b->add_to_back(l, v); t1 = now_ns();
+        model_insert(m, v, m->n);
+        break;
+      case OP_ADD_FRONT:
+        t0 = now_ns(); b->add_to_front(l, v); t1 = now_ns();
+        model_insert(m, v, 0);
+        break;
+      case OP_ADD_AT:
+        t0 = now_ns(); b->add_at_index(l, v, index); t1 = now_ns();
+        model_insert(m, v, index);
+        break;
+      case OP_REMOVE_BACK:
+        t0 = now_ns(); got = b->remove_from_back(l); t1 = now_ns();
+        expected = model_remove(m, m->n - 1);
+        break;
+      case OP_REMOVE_FRONT:
+        t0 = now_ns(); got = b->remove_from_front(l); t1 = now_ns();
+        expected = model_remove(m, 0);
+        break;
+      case OP_REMOVE_AT:
+        t0 = now_ns(); got = b->remove_at_index(l, index); t1 = now_ns();
+        expected = model_remove(m, index);
+        break;
+      case OP_IS_IN:
+        t0 = now_ns(); got = b->is_in(l, v); t1 = now_ns();
+        expected = model_index_of(m, v) != -1;
+        break;
+      case OP_GET_AT:
+        t0 = now_ns(); got = b->get_elem_at(l, index); t1 = now_ns();
+        expected = index >= 0 && index < m->n ? m->values[index] : -1;
+        break;
+      case OP_INDEX_OF:
+        t0 = now_ns(); got = b->get_index_of(l, v); t1 = now_ns();
+        expected = model_index_of(m, v);
+        break;
+      case OP_SORT:
+        t0 = now_ns(); b->sort(l); t1 = now_ns();
+        qsort(m->values, m->n, sizeof(elem), cmp_elem);
+        break;
+      case OP_SPLIT_SPLICE:
+        t0 = now_ns(); b->split_splice(l, index); t1 = now_ns();
+        break;
+      default:
+        t0 = t1 = 0;
+        break;
+    }
+    hist_add(&hists[op], t1 - t0);
+
+    if (got != expected) {
+      *f = (struct failure){ "result", expected, got };
+      ok = false;
+    } else if (b->length && b->length(l) != m->n) {
+      *f = (struct failure){ "length", m->n, b->length(l) };
+      ok = false;
+    } else if (b->to_string && (i % STRING_CHECK_EVERY == 0 || i == nops - 1)) {
+      char* want = model_to_string(m);
+      char* have = b->to_string(l);
+      if (strcmp(want, have) != 0) {
+        fprintf(stderr, "  expected %s\n  got      %s\n", want, have);
+        *f = (struct failure){ "contents", 0, 0 };
+        ok = false;
+      }
+      free(want);
+      free(have);
+    }
+  }
+
+  /* Without a ToString, drain the list and compare what comes out. */
+  if (ok && !b->to_string) {
+    for (int i = 0; i < m->n; i++) {
+      elem got = b->remove_from_front(l);
+      if (got != m->values[i]) {
+        *f = (struct failure){ "drain", m->values[i], got };
+        ok = false;
+        break;
+      }
+    }
+    elem extra;
+    if (ok && (extra = b->remove_from_front(l)) != -1) {
+      *f = (struct failure){ "drain past end", -1, extra };
+      ok = false;
+    }
+  }
+
+  b->free(l);
+  return ok;
+}
+
+static void print_hists(struct backend* b, struct hist* hists) {
+  printf("%s\n", b->name);
+  printf("  %-18s %10s %8s %8s %10s\n", "op", "count", "p50 ns", "p99 ns",
+         "max ns");
+  for (int op = 0; op < NOPS; op++) {
+    struct hist* h = &hists[op];
+    if (h->count == 0) continue;
+    printf("  %-18s %10ld %8llu %8llu %10llu\n", op_names[op], h->count,
+           (unsigned long long)hist_percentile(h, 0.50),
+           (unsigned long long)hist_percentile(h, 0.99),
+           (unsigned long long)h->max);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int nseq = argc > 1 ? atoi(argv[1]) : 20000;
+  int max_ops = argc > 2 ? atoi(argv[2]) : 512;
+  uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+  struct model m = { NULL, 0, 0 };
+  struct hist* hists = malloc(NOPS * sizeof(struct hist));
+  int failed = 0;
+
+  if (!hists) {
+    fprintf(stderr, "Fatal: malloc failed in main\n");
+    exit(1);
+  }
+  if (nseq < 1 || max_ops < 1) {
+    fprintf(stderr, "usage: %s [sequences] [max_ops_per_sequence] [seed]\n",
+            argv[0]);
+    return 1;
+  }
+
+  struct hist overhead = { 0 };
+  for (int i = 0; i < 100000; i++) {
+    uint64_t t0 = now_ns();
+    hist_add(&overhead, now_ns() - t0);
+  }
+  printf("%d sequences of up to %d ops, seed %llu; timer overhead p50 %llu ns\n",
+         nseq, max_ops, (unsigned long long)seed,
+         (unsigned long long)hist_percentile(&overhead, 0.50));
+
+  for (int bi = 0; bi < NBACKENDS; bi++) {
+    struct backend* b = &backends[bi];
+    memset(hists, 0, NOPS * sizeof(struct hist));
+    if (b->setup && !b->setup()) {
+      printf("%s: not supported by this CPU, skipped\n", b->name);
+      continue;
+    }
+
+    for (int s = 0; s < nseq; s++) {
+      struct failure f = {0};
+      int at_op;
+      enum op at;
+      /* each sequence has its own seed so it can be replayed alone */
+      rng_state = seed + s;
+      rng_state = rng_next() ^ 0x9e3779b97f4a7c15ull;
+      int nops = rng_range(1, max_ops);
+      if (!run_sequence(b, &m, nops, hists, &f, &at_op, &at)) {
+        fprintf(stderr,
+                "FAIL %s: %s mismatch at op %d (%s) of sequence %d: "
+                "expected %ld, got %ld\n"
+                "  replay with: %s 1 %d %llu\n",
+                b->name, f.what, at_op, op_names[at], s, f.expected, f.got,
+                argv[0], max_ops, (unsigned long long)(seed + s));
+        failed = 1;
+        break;
+      }
+    }
+    print_hists(b, hists);
+  }
+
+  free(m.values);
+  free(hists);
+  if (!failed) printf("all backends agree with the model\n");
+  return failed;
+}
@@ -0,0 +1,164 @@
+// list/glist.h
+//
+// Generic, type-specialized intrusive singly linked list.
+//
+// Instead of a fixed `typedef int elem`, the element type carries its own
+// next pointer and GLIST_DEFINE generates a list type plus static inline
+// operations for it. Searches and ordered inserts are generated by
+// GLIST_DEFINE_FIND and GLIST_DEFINE_INSERT_SORTED from a match/order
+// expression, so the comparison is inlined into the loop instead of going
+// through a function pointer. The list never allocates or frees elements;
+// that stays with the caller.
+//
+// Usage:
+//
+//   struct item { int key; struct item *next; };
+//   #define ITEM_KEY_EQ(e, k) ((e)->key == (k))
+//   #define ITEM_KEY_LT(a, b) ((a)->key < (b)->key)
+//
+//   GLIST_DEFINE(item_list, struct item, next)
+//   GLIST_DEFINE_FIND(item_list, find_key, struct item, next, int, ITEM_KEY_EQ)
+//   GLIST_DEFINE_INSERT_SORTED(item_list, insert_by_key, struct item, next, ITEM_KEY_LT)
+//
+// generates struct item_list, item_list_init, item_list_push_back, ...,
+// item_list_find_key and item_list_insert_by_key.
+//
+// <Author>
+
+#ifndef GLIST_H
+#define GLIST_H
+
+#include <stddef.h>
+
+/* Iterates over every element; the current element must not be unlinked. */
+#define GLIST_FOREACH(it, l, next) \
+	for ((it) = (l)->head; (it) != NULL; (it) = (it)->next)
+
+/* Generates the list type `struct name` and its basic operations. Every
+ * operation keeps head, tail and length consistent. Positions follow the
+ * lab-1 list: index 0 is the head. */
+#define GLIST_DEFINE(name, type, next)                                        \
+struct name {                                                                 \
+	type *head;                                                           \
+	type *tail;                                                           \
+	int length;                                                           \
+};                                                                            \
+                                                                              \
+static inline void name##_init(struct name *l)                                \
+{                                                                             \
+	l->head = NULL;                                                       \
+	l->tail = NULL;                                                       \
+	l->length = 0;                                                        \
+}                                                                             \
+                                                                              \
+static inline void name##_push_front(struct name *l, type *e)                 \
+{                                                                             \
+	e->next = l->head;                                                    \
+	l->head = e;                                                          \
+	if (l->tail == NULL) l->tail = e;                                     \
+	l->length++;                                                          \
+}                                                                             \
+                                                                              \
+static inline void name##_push_back(struct name *l, type *e)                  \
+{                                                                             \
+	e->next = NULL;                                                       \
+	if (l->tail) l->tail->next = e;                                       \
+	else l->head = e;                                                     \
+	l->tail = e;                                                          \
+	l->length++;                                                          \
+}                                                                             \
+                                                                              \
+/* Links e after prev, or at the front when prev is NULL. */                  \
+static inline void name##_insert_after(struct name *l, type *prev, type *e)   \
+{                                                                             \
+	if (prev == NULL) {                                                   \
+		name##_push_front(l, e);                                      \
+		return;                                                       \
+	}                                                                     \
+	e->next = prev->next;                                                 \
+	prev->next = e;                                                       \
+	if (l->tail == prev) l->tail = e;                                     \
+	l->length++;                                                          \
+}                                                                             \
+                                                                              \
+/* Unlinks and returns the element after prev (the head when prev is         \
+ * NULL), or NULL if there is none. */                                        \
+static inline type *name##_remove_after(struct name *l, type *prev)           \
+{                                                                             \
+	type *e = prev ? prev->next : l->head;                                \
+	if (e == NULL) return NULL;                                           \
+	if (prev) prev->next = e->next;                                       \
+	else l->head = e->next;                                               \
+	if (l->tail == e) l->tail = prev;                                     \
+	e->next = NULL;                                                       \
+	l->length--;                                                          \
+	return e;                                                             \
+}                                                                             \
+                                                                              \
+static inline type *name##_pop_front(struct name *l)                          \
+{                                                                             \
+	return name##_remove_after(l, NULL);                                  \
+}                                                                             \
+                                                                              \
+/* Returns the element at index (NULL if out of range); its predecessor is    \
+ * stored in *prev when prev is not NULL. */                                  \
+static inline type *name##_at(struct name *l, int index, type **prev)         \
+{                                                                             \
+	type *p = NULL, *e = l->head;                                         \
+	if (index < 0 || index >= l->length) return NULL;                     \
+	while (index-- > 0) {                                                 \
+		p = e;                                                        \
+		e = e->next;                                                  \
+	}                                                                     \
+	if (prev) *prev = p;                                                  \
+	return e;                                                             \
+}                                                                             \
+                                                                              \
+/* Unlinks e if it is in the list; returns e, or NULL if it was not found. */ \
+static inline type *name##_remove(struct name *l, type *e)                    \
+{                                                                             \
+	type *p = NULL, *cur = l->head;                                       \
+	while (cur && cur != e) {                                             \
+		p = cur;                                                      \
+		cur = cur->next;                                              \
+	}                                                                     \
+	return cur ? name##_remove_after(l, p) : NULL;                        \
+}
+
+/* Generates `type *name_fn(struct name *l, keytype key, type **prev,
+ * int *index)`, returning the first element e for which match(e, key) is
+ * true. Its predecessor and index are stored through prev and index when
+ * those are not NULL (index is -1 when nothing matches). */
+#define GLIST_DEFINE_FIND(name, fn, type, next, keytype, match)               \
+static inline type *name##_##fn(struct name *l, keytype key, type **prev,     \
+                                int *index)                                   \
+{                                                                             \
+	type *p = NULL, *e = l->head;                                         \
+	int i = 0;                                                            \
+	while (e && !(match(e, key))) {                                       \
+		p = e;                                                        \
+		e = e->next;                                                  \
+		i++;                                                          \
+	}                                                                     \
+	if (prev) *prev = p;                                                  \
+	if (index) *index = e ? i : -1;                                       \
+	return e;                                                             \
+}
+
+/* Generates `void name_fn(struct name *l, type *e)`, which links e before
+ * the first element x for which before(e, x) is true, or at the back. With
+ * a strict order this keeps equal elements in insertion order. The scan
+ * always starts at the head, so it behaves the same on lists that are not
+ * (or no longer) sorted by that order. */
+#define GLIST_DEFINE_INSERT_SORTED(name, fn, type, next, before)              \
+static inline void name##_##fn(struct name *l, type *e)                       \
+{                                                                             \
+	type *p = NULL, *cur = l->head;                                       \
+	while (cur && !(before(e, cur))) {                                    \
+		p = cur;                                                      \
+		cur = cur->next;                                              \
+	}                                                                     \
+	name##_insert_after(l, p, e);                                         \
+}
+
+#endif // GLIST_H
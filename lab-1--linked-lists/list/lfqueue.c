@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "lfqueue.h"
+
+#define LOAD(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define CAS(p, expected, desired) \
+  __atomic_compare_exchange_n((p), &(expected), (desired), false, \
+                              __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+
+/* ---- per-thread slot, shared by all queues ---- */
+
+static int slot_used[LFQ_MAX_THREADS];
+static __thread int my_slot = -1;
+static pthread_key_t slot_key;
+static pthread_once_t slot_once = PTHREAD_ONCE_INIT;
+
+static void slot_release(void* arg) {
+  STORE(&slot_used[(int)(long)arg - 1], 0);
+}
+
+static void slot_key_init() {
+  pthread_key_create(&slot_key, slot_release);
+}
+
+static int lfq_slot() {
+  if (my_slot >= 0) return my_slot;
+  pthread_once(&slot_once, slot_key_init);
+  for (int i = 0; i < LFQ_MAX_THREADS; i++) {
+    int expected = 0;
+    if (CAS(&slot_used[i], expected, 1)) {
+      my_slot = i;
+      /* stored as i + 1 since a NULL value never runs the destructor */
+      pthread_setspecific(slot_key, (void*)(long)(i + 1));
+      return i;
+    }
+  }
+  fprintf(stderr, "Fatal: more than %d threads using lfqueue\n", LFQ_MAX_THREADS);
+  exit(1);
+}
+
+/* ---- hazard pointers ---- */
+
+/* Publishes *src in hazard slot k and re-reads *src until the published
+ * value is still current, so the node cannot have been retired in between. */
+static node_t* protect(lfqueue_t* q, int slot, int k, node_t** src) {
+  node_t* p = LOAD(src);
+  for (;;) {
+    STORE(&q->hazard[slot].hp[k], p);
+    node_t* again = LOAD(src);
+    if (again == p) return p;
+    p = again;
+  }
+}
+
+static bool is_hazard(lfqueue_t* q, node_t* n) {
+  for (int i = 0; i < LFQ_MAX_THREADS; i++) {
+    if (LOAD(&q->hazard[i].hp[0]) == n || LOAD(&q->hazard[i].hp[1]) == n)
+      return true;
+  }
+  return false;
+}
+
+/* Frees every retired node of this thread that no hazard pointer covers. */
+static void scan(lfqueue_t* q, int slot) {
+  struct lfq_retired* r = &q->retired[slot];
+  int kept = 0;
+  for (int i = 0; i < r->count; i++) {
+    if (is_hazard(q, r->nodes[i])) r->nodes[kept++] = r->nodes[i];
+    else free(r->nodes[i]);
+  }
+  r->count = kept;
+}
+
+static void retire(lfqueue_t* q, int slot, node_t* n) {
+  struct lfq_retired* r = &q->retired[slot];
+  if (r->count == r->cap) {
+    int cap = r->cap ? r->cap * 2 : LFQ_RETIRE_THRESHOLD;
+    node_t** nodes = realloc(r->nodes, cap * sizeof(node_t*));
+    if (!nodes) {
+      fprintf(stderr, "Fatal: realloc failed in retire\n");
+      exit(1);
+    }
+    r->nodes = nodes;
+    r->cap = cap;
+  }
+  r->nodes[r->count++] = n;
+  if (r->count >= LFQ_RETIRE_THRESHOLD) scan(q, slot);
+}
+
+/* ---- queue ---- */
+
+lfqueue_t* lfq_alloc() {
+  lfqueue_t* q;
+  if (posix_memalign((void**)&q, LFQ_CACHE_LINE, sizeof(lfqueue_t)) != 0) {
+    fprintf(stderr, "Fatal: posix_memalign failed in lfq_alloc\n");
+    exit(1);
+  }
+  memset(q, 0, sizeof(lfqueue_t));
+  node_t* dummy = getNode(0);
+  q->head = dummy;
+  q->tail = dummy;
+  return q;
+}
+
+void lfq_free(lfqueue_t* q) {
+  if (!q) return;
+  node_t* curr = q->head;
+  while (curr) {
+    node_t* tmp = curr;
+    curr = curr->next;
+    free(tmp);
+  }
+  for (int i = 0; i < LFQ_MAX_THREADS; i++) {
+    for (int j = 0; j < q->retired[i].count; j++) free(q->retired[i].nodes[j]);
+    free(q->retired[i].nodes);
+  }
+  free(q);
+}
+
+void lfq_add_to_back(lfqueue_t* q, elem value) {
+  int slot = lfq_slot();
+  node_t* n = getNode(value);
+
+  for (;;) {
+    node_t* tail = protect(q, slot, 0, &q->tail);
+    node_t* next = LOAD(&tail->next);
+    if (tail != LOAD(&q->tail)) continue;
+    if (next) {
+      /* another enqueue linked its node but has not swung tail yet */
+      CAS(&q->tail, tail, next);
+      continue;
+    }
+    node_t* expected = NULL;
+    if (CAS(&tail->next, expected, n)) {
+      CAS(&q->tail, tail, n);
+      break;
+    }
+  }
+  STORE(&q->hazard[slot].hp[0], NULL);
+}
+
+bool lfq_try_remove_from_front(lfqueue_t* q, elem* value) {
+  int slot = lfq_slot();
+  node_t* head;
+
+  for (;;) {
+    head = protect(q, slot, 0, &q->head);
+    node_t* tail = LOAD(&q->tail);
+    node_t* next = protect(q, slot, 1, &head->next);
+    if (head != LOAD(&q->head)) continue;
+    if (!next) {
+      STORE(&q->hazard[slot].hp[0], NULL);
+      STORE(&q->hazard[slot].hp[1], NULL);
+      return false;
+    }
+    if (head == tail) {
+      CAS(&q->tail, tail, next);
+      continue;
+    }
+    /* next becomes the new dummy; its value is read while it is protected */
+    *value = next->value;
+    if (CAS(&q->head, head, next)) break;
+  }
+
+  STORE(&q->hazard[slot].hp[0], NULL);
+  STORE(&q->hazard[slot].hp[1], NULL);
+  retire(q, slot, head);
+  return true;
+}
+
+elem lfq_remove_from_front(lfqueue_t* q) {
+  elem value;
+  return lfq_try_remove_from_front(q, &value) ? value : -1;
+}
+
+bool lfq_is_empty(lfqueue_t* q) {
+  int slot = lfq_slot();
+  node_t* head = protect(q, slot, 0, &q->head);
+  bool empty = LOAD(&head->next) == NULL;
+  STORE(&q->hazard[slot].hp[0], NULL);
+  return empty;
+}
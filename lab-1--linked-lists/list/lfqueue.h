@@ -0,0 +1,70 @@
+// list/lfqueue.h
+//
+// Interface definition for a lock-free multi-producer multi-consumer queue
+// (Michael & Scott) built on the list's node_t. It replaces the pattern of
+// guarding list_add_to_back / list_remove_from_front with one mutex.
+// Removed nodes are reclaimed with hazard pointers, so a node is only freed
+// once no thread can still be reading it.
+//
+// <Author>
+
+#ifndef LFQUEUE_H
+#define LFQUEUE_H
+
+#include <stdbool.h>
+#include "list.h"
+
+/* Maximum number of threads using queues at the same time. A thread claims
+ * a slot on its first queue operation and gives it back when it exits. */
+#define LFQ_MAX_THREADS 64
+
+/* Retired nodes are scanned against the hazard pointers once a thread has
+ * this many waiting. */
+#define LFQ_RETIRE_THRESHOLD (4 * LFQ_MAX_THREADS)
+
+#define LFQ_CACHE_LINE 64
+
+/* Two hazard pointers per thread, padded so threads do not share a line. */
+struct lfq_hazard {
+	node_t *hp[2];
+	char pad[LFQ_CACHE_LINE - 2 * sizeof(node_t *)];
+};
+
+/* Nodes a thread has unlinked but not freed yet. */
+struct lfq_retired {
+	node_t **nodes;
+	int count;
+	int cap;
+};
+
+/* head always points at a dummy node; the front element is head->next.
+ * head and tail sit on separate cache lines so producers and consumers do
+ * not contend on the same line. */
+struct lfqueue {
+	node_t *head;
+	char pad1[LFQ_CACHE_LINE - sizeof(node_t *)];
+	node_t *tail;
+	char pad2[LFQ_CACHE_LINE - sizeof(node_t *)];
+	struct lfq_hazard hazard[LFQ_MAX_THREADS];
+	struct lfq_retired retired[LFQ_MAX_THREADS];
+};
+typedef struct lfqueue lfqueue_t;
+
+/* Allocation and freeing are not thread safe: no other thread may be using
+ * the queue while lfq_free runs. */
+lfqueue_t *lfq_alloc();
+void lfq_free(lfqueue_t *q);
+
+/* Thread-safe operations. */
+void lfq_add_to_back(lfqueue_t *q, elem value);
+
+/* Removes the front element into *value; returns false if the queue was
+ * empty. */
+bool lfq_try_remove_from_front(lfqueue_t *q, elem *value);
+
+/* Same as list_remove_from_front: returns -1 if the queue is empty. */
+elem lfq_remove_from_front(lfqueue_t *q);
+
+bool lfq_is_empty(lfqueue_t *q);
+
+#endif // LFQUEUE_H
@@ -10,23 +10,109 @@ node_t* getNode(elem value) {
   return newNode;
 }
 
+/* Chunks start small so short lists stay cheap and double up to the cap. */
+#define POOL_FIRST_CHUNK 64
+#define POOL_MAX_CHUNK 65536
+
+void pool_init(node_pool_t* p) {
+  p->chunks = NULL;
+  p->oldest = NULL;
+  p->used = 0;
+  p->free_nodes = NULL;
+  p->live = 0;
+  p->nchunks = 0;
+  p->bytes = 0;
+}
+
+node_t* pool_get(node_pool_t* p, elem value) {
+  node_t* n;
+  if (p->free_nodes) {
+    n = p->free_nodes;
+    p->free_nodes = n->next;
+  } else {
+    if (!p->chunks || p->used == p->chunks->capacity) {
+      int cap = p->chunks ? p->chunks->capacity * 2 : POOL_FIRST_CHUNK;
+      if (cap > POOL_MAX_CHUNK) cap = POOL_MAX_CHUNK;
+      size_t size = sizeof(node_chunk_t) + (size_t)cap * sizeof(node_t);
+      node_chunk_t* c = malloc(size);
+      if (!c) {
+        fprintf(stderr, "Fatal: malloc failed in pool_get\n");
+        exit(1);
+      }
+      c->capacity = cap;
+      c->next = p->chunks;
+      p->chunks = c;
+      if (!p->oldest) p->oldest = c;
+      p->used = 0;
+      p->nchunks++;
+      p->bytes += size;
+    }
+    n = &p->chunks->nodes[p->used++];
+  }
+  n->value = value;
+  n->next = NULL;
+  p->live++;
+  return n;
+}
+
+void pool_put(node_pool_t* p, node_t* n) {
+  n->next = p->free_nodes;
+  p->free_nodes = n;
+  p->live--;
+}
+
+void pool_release(node_pool_t* p) {
+  node_chunk_t* c = p->chunks;
+  while (c) {
+    node_chunk_t* tmp = c;
+    c = c->next;
+    free(tmp);
+  }
+  pool_init(p);
+}
+
+void pool_adopt(node_pool_t* dst, node_pool_t* src) {
+  if (!src->chunks) return;
+  if (!dst->chunks) {
+    *dst = *src;
+  } else {
+    /* dst keeps carving from its own newest chunk */
+    dst->oldest->next = src->chunks;
+    dst->oldest = src->oldest;
+    if (src->free_nodes) {
+      node_t* last = src->free_nodes;
+      while (last->next) last = last->next;
+      last->next = dst->free_nodes;
+      dst->free_nodes = src->free_nodes;
+    }
+    dst->live += src->live;
+    dst->nchunks += src->nchunks;
+    dst->bytes += src->bytes;
+  }
+  pool_init(src);
+}
+
 list_t* list_alloc() {
   list_t* l = malloc(sizeof(list_t));
   l->head = NULL;
+  l->tail = NULL;
+  l->length = 0;
+  pool_init(&l->pool);
   return l;
 }
 
 void list_free(list_t* l) {
   if (!l) return;
-  node_t* curr = l->head;
-  while (curr) {
-    node_t* tmp = curr;
-    curr = curr->next;
-    free(tmp);
-  }
+  pool_release(&l->pool);
   free(l);
 }
 
+void list_alloc_stats(list_t* l, list_stats_t* stats) {
+  stats->live_nodes = l->pool.live;
+  stats->chunks = l->pool.nchunks;
+  stats->bytes = l->pool.bytes;
+}
+
 void list_print(list_t* l) {
   if (!l) return;
   node_t* curr = l->head;
@@ -37,53 +123,112 @@ void list_print(list_t* l) {
   printf("\n");
 }
 
-char* listToString(list_t *l) {
-  if (!l) return NULL;
+void strbuf_init(strbuf_t* sb, char* buf, size_t cap) {
+  sb->growable = (buf == NULL);
+  if (sb->growable) {
+    cap = cap ? cap : 64;
+    buf = malloc(cap);
+    if (!buf) {
+      fprintf(stderr, "Fatal: malloc failed in strbuf_init\n");
+      exit(1);
+    }
+  }
+  sb->data = buf;
+  sb->cap = cap;
+  sb->len = 0;
+  if (cap) buf[0] = '\0';
+}
 
-  char *buffer = malloc(1024);
-  buffer[0] = '\0';
+int strbuf_writer(void* ctx, const char* chunk, size_t len) {
+  strbuf_t* sb = ctx;
+  if (sb->growable && sb->len + len + 1 > sb->cap) {
+    size_t cap = sb->cap;
+    while (sb->len + len + 1 > cap) cap *= 2;
+    char* data = realloc(sb->data, cap);
+    if (!data) return -1;
+    sb->data = data;
+    sb->cap = cap;
+  }
+  /* fixed buffers copy what fits but keep counting */
+  if (sb->len + 1 < sb->cap) {
+    size_t room = sb->cap - sb->len - 1;
+    size_t n = len < room ? len : room;
+    memcpy(sb->data + sb->len, chunk, n);
+    sb->data[sb->len + n] = '\0';
+  }
+  sb->len += len;
+  return 0;
+}
 
-  node_t* curr = l->head;
-  char temp[50];
+int list_writer_file(void* ctx, const char* chunk, size_t len) {
+  return fwrite(chunk, 1, len, (FILE*)ctx) == len ? 0 : -1;
+}
 
-  while (curr) {
-    sprintf(temp, "%d->", curr->value);
-    strcat(buffer, temp);
-    curr = curr->next;
+int list_write(list_t* l, list_writer w, void* ctx) {
+  char chunk[LIST_WRITE_CHUNK];
+  size_t used = 0;
+  int rc;
+
+  for (node_t* curr = l->head; curr; curr = curr->next) {
+    /* an int plus "->" needs at most 13 bytes */
+    if (used + 16 > sizeof(chunk)) {
+      if ((rc = w(ctx, chunk, used)) != 0) return rc;
+      used = 0;
+    }
+    used += sprintf(chunk + used, "%d->", curr->value);
   }
 
-  strcat(buffer, "NULL");
-  return buffer;
+  memcpy(chunk + used, "NULL", 4);
+  return w(ctx, chunk, used + 4);
 }
 
-int list_length(list_t* l) {
-  int count = 0;
-  node_t* curr = l->head;
-  while (curr) {
-    count++;
-    curr = curr->next;
+size_t list_to_buffer(list_t* l, char* buf, size_t cap) {
+  strbuf_t sb;
+  if (buf && cap) {
+    strbuf_init(&sb, buf, cap);
+  } else {
+    /* size query only, nothing is stored */
+    sb.data = NULL;
+    sb.len = sb.cap = 0;
+    sb.growable = false;
+  }
+  list_write(l, strbuf_writer, &sb);
+  return sb.len;
+}
+
+char* listToString(list_t *l) {
+  if (!l) return NULL;
+
+  strbuf_t sb;
+  strbuf_init(&sb, NULL, (size_t)l->length * 4 + 5);
+  if (list_write(l, strbuf_writer, &sb) != 0) {
+    free(sb.data);
+    return NULL;
   }
-  return count;
+  return sb.data;
+}
+
+int list_length(list_t* l) {
+  return l->length;
 }
 
 void list_add_to_back(list_t* l, elem value) {
-  node_t* n = getNode(value);
+  node_t* n = pool_get(&l->pool, value);
   if (!l->head) {
     l->head = n;
-    return;
+  } else {
+    l->tail->next = n;
   }
-
-  node_t* curr = l->head;
-  while (curr->next) {
-    curr = curr->next;
-  }
-  curr->next = n;
+  l->tail = n;
+  l->length++;
 }
 
 void list_add_to_front(list_t* l, elem value) {
-  node_t* n = getNode(value);
+  node_t* n = pool_get(&l->pool, value);
   n->next = l->head;
   l->head = n;
+  if (!l->tail) l->tail = n;
+  l->length++;
 }
 
 void list_add_at_index(list_t* l, elem value, int index) {
@@ -100,9 +245,11 @@ void list_add_at_index(list_t* l, elem value, int index) {
     i++;
   }
 
-  node_t* n = getNode(value);
+  node_t* n = pool_get(&l->pool, value);
   n->next = curr->next;
   curr->next = n;
+  if (l->tail == curr) l->tail = n;
+  l->length++;
 }
 
 elem list_remove_from_back(list_t* l) {
@@ -110,19 +257,24 @@ elem list_remove_from_back(list_t* l) {
 
   if (!l->head->next) {
     elem val = l->head->value;
-    free(l->head);
+    pool_put(&l->pool, l->head);
     l->head = NULL;
+    l->tail = NULL;
+    l->length = 0;
     return val;
   }
 
+  /* singly linked: the new tail still has to be found by walking */
   node_t* curr = l->head;
-  while (curr->next->next) {
+  while (curr->next != l->tail) {
     curr = curr->next;
   }
 
-  elem val = curr->next->value;
-  free(curr->next);
+  elem val = l->tail->value;
+  pool_put(&l->pool, l->tail);
   curr->next = NULL;
+  l->tail = curr;
+  l->length--;
   return val;
 }
 
@@ -131,7 +283,9 @@ elem list_remove_from_front(list_t* l) {
   node_t* tmp = l->head;
   elem val = tmp->value;
   l->head = tmp->next;
-  free(tmp);
+  if (!l->head) l->tail = NULL;
+  pool_put(&l->pool, tmp);
+  l->length--;
   return val;
 }
 
@@ -152,7 +306,9 @@ elem list_remove_at_index(list_t* l, int index) {
   node_t* tmp = curr->next;
   elem val = tmp->value;
   curr->next = tmp->next;
-  free(tmp);
+  if (l->tail == tmp) l->tail = curr;
+  pool_put(&l->pool, tmp);
+  l->length--;
   return val;
 }
 
@@ -187,3 +343,114 @@ int list_get_index_of(list_t* l, elem value) {
   }
   return -1;
 }
+
+list_t* list_from_array(const elem* values, int n) {
+  list_t* l = list_alloc();
+  list_append_array(l, values, n);
+  return l;
+}
+
+void list_append_array(list_t* l, const elem* values, int n) {
+  if (!l || n <= 0) return;
+  node_t* first = pool_get(&l->pool, values[0]);
+  node_t* last = first;
+  for (int i = 1; i < n; i++) {
+    last->next = pool_get(&l->pool, values[i]);
+    last = last->next;
+  }
+  if (l->tail) l->tail->next = first;
+  else l->head = first;
+  l->tail = last;
+  l->length += n;
+}
+
+void list_splice(list_t* dst, list_t* src) {
+  if (!dst || !src || dst == src || !src->head) return;
+  if (dst->tail) dst->tail->next = src->head;
+  else dst->head = src->head;
+  dst->tail = src->tail;
+  dst->length += src->length;
+  pool_adopt(&dst->pool, &src->pool);
+  src->head = NULL;
+  src->tail = NULL;
+  src->length = 0;
+}
+
+list_t* list_split(list_t* l, int index) {
+  list_t* rest = list_alloc();
+  if (!l || index >= l->length) return rest;
+  if (index < 0) index = 0;
+
+  node_t* prev = NULL;
+  node_t* curr = l->head;
+  for (int i = 0; i < index; i++) {
+    prev = curr;
+    curr = curr->next;
+  }
+
+  if (prev) prev->next = NULL;
+  else l->head = NULL;
+  l->tail = prev;
+  rest->length = l->length - index;
+  l->length = index;
+
+  /* copy the suffix into rest's own pool and recycle the old nodes */
+  node_t* last = NULL;
+  while (curr) {
+    node_t* n = pool_get(&rest->pool, curr->value);
+    if (last) last->next = n;
+    else rest->head = n;
+    last = n;
+    node_t* tmp = curr;
+    curr = curr->next;
+    pool_put(&l->pool, tmp);
+  }
+  rest->tail = last;
+  return rest;
+}
+
+void list_sort(list_t* l) {
+  if (!l || l->length < 2) return;
+
+  node_t* list = l->head;
+  node_t* tail;
+  int merges;
+
+  /* merge runs of width 1, 2, 4, ... until a single run is left */
+  for (int width = 1;; width *= 2) {
+    node_t* p = list;
+    list = NULL;
+    tail = NULL;
+    merges = 0;
+
+    while (p) {
+      merges++;
+      node_t* q = p;
+      int psize = 0, qsize = width;
+      while (psize < width && q) {
+        psize++;
+        q = q->next;
+      }
+
+      while (psize > 0 || (qsize > 0 && q)) {
+        node_t* e;
+        if (psize == 0) {
+          e = q; q = q->next; qsize--;
+        } else if (qsize == 0 || !q || p->value <= q->value) {
+          e = p; p = p->next; psize--;
+        } else {
+          e = q; q = q->next; qsize--;
+        }
+        if (tail) tail->next = e;
+        else list = e;
+        tail = e;
+      }
+      p = q;
+    }
+    tail->next = NULL;
+    if (merges <= 1) break;
+  }
+
+  l->head = list;
+  l->tail = tail;
+}
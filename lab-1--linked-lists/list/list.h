@@ -4,7 +4,11 @@
 //
 // <Author>
 
+#ifndef LIST_H
+#define LIST_H
+
 #include <stdbool.h>
+#include <stddef.h>
 
 /* Defines the type of the elements in the linked list. You may change this if
  * you want! */
@@ -19,10 +23,44 @@ struct node {
 };
 typedef struct node node_t;
 
-/* Defines the list structure, which simply points to the first node in the
- * list. */
+/* Nodes are carved out of large chunks instead of one malloc per node. The
+ * chunks of a pool are chained together so the whole pool can be released in
+ * O(chunks), and freed nodes are recycled through an intrusive free list that
+ * reuses their next pointer. */
+struct node_chunk {
+	struct node_chunk *next;
+	int capacity;
+	node_t nodes[];
+};
+typedef struct node_chunk node_chunk_t;
+
+struct node_pool {
+	node_chunk_t *chunks;   /* most recently allocated chunk first */
+	node_chunk_t *oldest;   /* last chunk in the chain, for O(1) adoption */
+	int used;               /* nodes handed out from chunks->nodes so far */
+	node_t *free_nodes;     /* recycled nodes, linked through next */
+	long live;              /* nodes currently in use */
+	long nchunks;
+	size_t bytes;           /* total bytes held by the chunks */
+};
+typedef struct node_pool node_pool_t;
+
+/* Allocator statistics reported by list_alloc_stats. */
+struct list_stats {
+	long live_nodes;
+	long chunks;
+	size_t bytes;
+};
+typedef struct list_stats list_stats_t;
+
+/* Defines the list structure, which points to the first and last node in the
+ * list and caches the number of elements. Every mutator keeps tail and length
+ * up to date so that list_add_to_back and list_length are O(1). */
 struct list {
 	node_t *head;
+	node_t *tail;
+	int length;
+	node_pool_t pool;
 };
 typedef struct list list_t;
 
@@ -35,11 +73,57 @@ void list_free(list_t *l);
 /* Prints the list in some format. */
 void list_print(list_t *l);
 
-/* returns string of List */
+/* returns string of List; the caller frees it */
 char* listToString(list_t *l);
-/* returns node from heap */
+
+/* Chunked output callback used by list_write. It receives the serialized list
+ * piece by piece; returning non-zero stops the write and list_write returns
+ * that value. */
+typedef int (*list_writer)(void *ctx, const char *chunk, size_t len);
+
+/* Streams the list in listToString format ("1->2->NULL") through w, at most
+ * LIST_WRITE_CHUNK bytes at a time, so no full-size string is ever built. */
+#define LIST_WRITE_CHUNK 4096
+int list_write(list_t *l, list_writer w, void *ctx);
+
+/* list_writer that fwrite()s each chunk to the FILE* passed as ctx. */
+int list_writer_file(void *ctx, const char *chunk, size_t len);
+
+/* Output buffer with a write cursor. A growable buffer (strbuf_init with
+ * buf == NULL) reallocs as needed; a caller-provided buffer never grows and
+ * silently truncates, but len still counts every byte written so the caller
+ * can tell how much space was needed. data is always NUL-terminated. */
+struct strbuf {
+	char *data;
+	size_t len;
+	size_t cap;
+	bool growable;
+};
+typedef struct strbuf strbuf_t;
+
+void strbuf_init(strbuf_t *sb, char *buf, size_t cap);
+int strbuf_writer(void *ctx, const char *chunk, size_t len);
+
+/* Serializes into buf (capacity cap) like snprintf: returns the full length
+ * of the string, which is >= cap when the output was truncated. */
+size_t list_to_buffer(list_t *l, char *buf, size_t cap);
+/* returns node from heap; the caller owns it and releases it with free() */
 node_t * getNode(elem value);
 
+/* Node pool used by every list for its own nodes. */
+void pool_init(node_pool_t *p);
+node_t *pool_get(node_pool_t *p, elem value);
+void pool_put(node_pool_t *p, node_t *n);
+void pool_release(node_pool_t *p);
+
+/* Moves all of src's chunks and free nodes into dst, leaving src empty.
+ * The chunks move in O(1); src's free nodes are chained onto dst's in
+ * O(free nodes in src) so they are reused rather than stranded. */
+void pool_adopt(node_pool_t *dst, node_pool_t *src);
+
+/* Reports live nodes, chunks and bytes held by the list's node pool. */
+void list_alloc_stats(list_t *l, list_stats_t *stats);
+
 /* Returns the length of the list. */
 int list_length(list_t *l);
 
@@ -61,3 +145,26 @@ elem list_get_elem_at(list_t *l, int index);
 
 /* Returns the index at which the given element appears. return -1 if does not exist */
 int list_get_index_of(list_t *l, elem value);
+
+/* Bulk operations. */
+
+/* Builds a list from values[0..n-1] in one pass. */
+list_t *list_from_array(const elem *values, int n);
+
+/* Appends values[0..n-1] to the back of the list in one pass. */
+void list_append_array(list_t *l, const elem *values, int n);
+
+/* Moves every element of src onto the back of dst in O(1) plus the length
+ * of src's free node list; src is left empty but still allocated. */
+void list_splice(list_t *dst, list_t *src);
+
+/* Splits the list at index: elements [index, length) are moved to a newly
+ * allocated list, which is returned (empty if index >= length). Costs
+ * O(length) since the moved nodes are copied into the new list's pool. */
+list_t *list_split(list_t *l, int index);
+
+/* Sorts the list in ascending order in place. Bottom-up merge sort on the
+ * nodes themselves: stable, O(n log n), and no allocation. */
+void list_sort(list_t *l);
+
+#endif // LIST_H
@@ -209,5 +209,26 @@ int main() {
   // list_add_to_back(mylist, 40);
   // list_print(mylist);
   // printf("Index of %d?: %d\n", 40, list_get_index_of(mylist, 40));
+  list_t *front = list_alloc(), *back = list_alloc();
+  list_stats_t stats;
+  for (x = 0; x < 64; x++) list_add_to_back(front, x);
+  for (x = 0; x < 64; x++) list_add_to_back(back, x);
+  for (x = 0; x < 8; x++) list_remove_from_front(back);
+  list_splice(front, back);
+  for (x = 0; x < 4; x++) list_remove_from_back(front);
+  list_alloc_stats(front, &stats);
+  if(stats.live_nodes != list_length(front) || stats.chunks != 2)
+  {
+        printf("list_splice : FAILED\n");
+  }
+  /* the 12 recycled nodes, 8 of them from back, fill these without a new chunk */
+  for (x = 0; x < 12; x++) list_add_to_back(front, x);
+  list_alloc_stats(front, &stats);
+  if(stats.live_nodes != list_length(front) || stats.chunks != 2)
+  {
+        printf("list_splice : FAILED\n");
+  }
+  list_free(front);
+  list_free(back);
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sklist.h"
+
+static sknode_t* sknode_alloc(elem value, int level) {
+  sknode_t* n = malloc(sizeof(sknode_t) + level * sizeof(struct sklink));
+  if (!n) {
+    fprintf(stderr, "Fatal: malloc failed in sknode_alloc\n");
+    exit(1);
+  }
+  n->value = value;
+  n->level = level;
+  return n;
+}
+
+/* Each extra level is kept with probability 1/4 (xorshift32 per list). */
+static int random_level(sklist_t* l) {
+  int level = 1;
+  unsigned int x = l->seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  l->seed = x;
+  while ((x & 3) == 0 && level < SKLIST_MAX_LEVEL) {
+    level++;
+    x >>= 2;
+  }
+  return level;
+}
+
+/* Finds, on every level, the last node whose position is <= pos (the head
+ * is position 0, the element at index i is position i + 1). Fills update[]
+ * with those nodes and rank[] with their positions. */
+static sknode_t* sklist_seek(sklist_t* l, int pos, sknode_t** update, int* rank) {
+  sknode_t* x = l->head;
+  int r = 0;
+  for (int i = l->level - 1; i >= 0; i--) {
+    while (x->links[i].next && r + x->links[i].width <= pos) {
+      r += x->links[i].width;
+      x = x->links[i].next;
+    }
+    if (update) {
+      update[i] = x;
+      rank[i] = r;
+    }
+  }
+  return x;
+}
+
+/* Inserts value so that it ends up at index pos (0 <= pos <= length). */
+static void sklist_insert(sklist_t* l, elem value, int pos) {
+  sknode_t* update[SKLIST_MAX_LEVEL];
+  int rank[SKLIST_MAX_LEVEL];
+  int level = random_level(l);
+
+  sklist_seek(l, pos, update, rank);
+  for (int i = l->level; i < level; i++) {
+    l->head->links[i].next = NULL;
+    l->head->links[i].width = l->length + 1;
+    update[i] = l->head;
+    rank[i] = 0;
+  }
+  if (level > l->level) l->level = level;
+
+  sknode_t* n = sknode_alloc(value, level);
+  for (int i = 0; i < level; i++) {
+    struct sklink* prev = &update[i]->links[i];
+    int before = pos - rank[i];  /* positions from update[i] up to the new node, minus one */
+    n->links[i].next = prev->next;
+    n->links[i].width = prev->width - before;
+    prev->next = n;
+    prev->width = before + 1;
+  }
+  for (int i = level; i < l->level; i++) {
+    update[i]->links[i].width++;
+  }
+  l->length++;
+}
+
+/* Removes and returns the element at index pos (0 <= pos < length). */
+static elem sklist_delete(sklist_t* l, int pos) {
+  sknode_t* update[SKLIST_MAX_LEVEL];
+  int rank[SKLIST_MAX_LEVEL];
+
+  sklist_seek(l, pos, update, rank);
+  sknode_t* target = update[0]->links[0].next;
+  for (int i = 0; i < l->level; i++) {
+    struct sklink* prev = &update[i]->links[i];
+    if (prev->next == target) {
+      prev->width += target->links[i].width - 1;
+      prev->next = target->links[i].next;
+    } else {
+      prev->width--;
+    }
+  }
+  while (l->level > 1 && !l->head->links[l->level - 1].next) {
+    l->level--;
+  }
+
+  elem val = target->value;
+  free(target);
+  l->length--;
+  return val;
+}
+
+sklist_t* sklist_alloc() {
+  sklist_t* l = malloc(sizeof(sklist_t));
+  l->head = sknode_alloc(0, SKLIST_MAX_LEVEL);
+  l->head->links[0].next = NULL;
+  l->head->links[0].width = 1;
+  l->level = 1;
+  l->length = 0;
+  l->seed = 2463534242u;
+  return l;
+}
+
+void sklist_free(sklist_t* l) {
+  if (!l) return;
+  sknode_t* curr = l->head;
+  while (curr) {
+    sknode_t* tmp = curr;
+    curr = curr->links[0].next;
+    free(tmp);
+  }
+  free(l);
+}
+
+void sklist_print(sklist_t* l) {
+  if (!l) return;
+  for (sknode_t* curr = l->head->links[0].next; curr; curr = curr->links[0].next) {
+    printf("%d ", curr->value);
+  }
+  printf("\n");
+}
+
+char* sklistToString(sklist_t* l) {
+  if (!l) return NULL;
+
+  /* at most 11 digits plus "->" per element, then "NULL" */
+  char* buffer = malloc((size_t)l->length * 13 + 5);
+  char* cursor = buffer;
+
+  for (sknode_t* curr = l->head->links[0].next; curr; curr = curr->links[0].next) {
+    cursor += sprintf(cursor, "%d->", curr->value);
+  }
+
+  strcpy(cursor, "NULL");
+  return buffer;
+}
+
+int sklist_length(sklist_t* l) {
+  return l->length;
+}
+
+void sklist_add_to_back(sklist_t* l, elem value) {
+  sklist_insert(l, value, l->length);
+}
+
+void sklist_add_to_front(sklist_t* l, elem value) {
+  sklist_insert(l, value, 0);
+}
+
+void sklist_add_at_index(sklist_t* l, elem value, int index) {
+  if (!l) return;
+  if (index < 0) index = 0;
+  if (index > l->length) index = l->length;
+  sklist_insert(l, value, index);
+}
+
+elem sklist_remove_from_back(sklist_t* l) {
+  if (!l || l->length == 0) return -1;
+  return sklist_delete(l, l->length - 1);
+}
+
+elem sklist_remove_from_front(sklist_t* l) {
+  if (!l || l->length == 0) return -1;
+  return sklist_delete(l, 0);
+}
+
+elem sklist_remove_at_index(sklist_t* l, int index) {
+  if (!l || l->length == 0) return -1;
+  if (index < 0) index = 0;
+  if (index >= l->length) return -1;
+  return sklist_delete(l, index);
+}
+
+bool sklist_is_in(sklist_t* l, elem value) {
+  return sklist_get_index_of(l, value) != -1;
+}
+
+elem sklist_get_elem_at(sklist_t* l, int index) {
+  if (!l || index < 0 || index >= l->length) return -1;
+  return sklist_seek(l, index + 1, NULL, NULL)->value;
+}
+
+int sklist_get_index_of(sklist_t* l, elem value) {
+  int index = 0;
+  for (sknode_t* curr = l->head->links[0].next; curr; curr = curr->links[0].next) {
+    if (curr->value == value) return index;
+    index++;
+  }
+  return -1;
+}
@@ -0,0 +1,65 @@
+// list/sklist.h
+//
+// Interface definition for the indexable skip list. It offers the same
+// operations as list.h with the same index and error semantics. Each forward
+// pointer also stores its span width (how many positions it skips), so
+// list_get_elem_at, list_add_at_index and list_remove_at_index run in
+// expected O(log n) instead of O(index).
+//
+// <Author>
+
+#ifndef SKLIST_H
+#define SKLIST_H
+
+#include <stdbool.h>
+#include "list.h"
+
+/* Enough levels for 4^32 elements with the 1/4 promotion probability. */
+#define SKLIST_MAX_LEVEL 32
+
+/* A forward pointer and the number of positions it advances. A NULL next
+ * has the width to one past the last element. */
+struct sklink {
+	struct sknode *next;
+	int width;
+};
+
+/* Defines the skip list node; links[0] is the plain singly linked chain. */
+struct sknode {
+	elem value;
+	int level;
+	struct sklink links[];
+};
+typedef struct sknode sknode_t;
+
+/* head is a sentinel with SKLIST_MAX_LEVEL links at position 0; level is the
+ * number of levels currently in use. */
+struct sklist {
+	sknode_t *head;
+	int level;
+	int length;
+	unsigned int seed;
+};
+typedef struct sklist sklist_t;
+
+sklist_t *sklist_alloc();
+void sklist_free(sklist_t *l);
+
+void sklist_print(sklist_t *l);
+char* sklistToString(sklist_t *l);
+
+int sklist_length(sklist_t *l);
+
+void sklist_add_to_back(sklist_t *l, elem value);
+void sklist_add_to_front(sklist_t *l, elem value);
+void sklist_add_at_index(sklist_t *l, elem value, int index);
+
+elem sklist_remove_from_back(sklist_t *l);
+elem sklist_remove_from_front(sklist_t *l);
+elem sklist_remove_at_index(sklist_t *l, int index);
+
+bool sklist_is_in(sklist_t *l, elem value);
+elem sklist_get_elem_at(sklist_t *l, int index);
+int sklist_get_index_of(sklist_t *l, elem value);
+
+#endif // SKLIST_H
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ulist.h"
+
+static unode_t* unode_alloc() {
+  unode_t* n = malloc(sizeof(unode_t));
+  if (!n) {
+    fprintf(stderr, "Fatal: malloc failed in unode_alloc\n");
+    exit(1);
+  }
+  n->next = NULL;
+  n->count = 0;
+  return n;
+}
+
+/* Finds the node holding position index (0 <= index < length). The slot
+ * inside that node goes to *off and its predecessor to *prev. */
+static unode_t* ulist_locate(ulist_t* l, int index, unode_t** prev, int* off) {
+  unode_t* p = NULL;
+  unode_t* curr = l->head;
+  while (index >= curr->count) {
+    index -= curr->count;
+    p = curr;
+    curr = curr->next;
+  }
+  if (prev) *prev = p;
+  *off = index;
+  return curr;
+}
+
+/* Inserts value at slot off of n, splitting n in half first when it is full. */
+static void unode_insert(ulist_t* l, unode_t* n, int off, elem value) {
+  if (n->count == ULIST_NODE_CAP) {
+    int half = ULIST_NODE_CAP / 2;
+    unode_t* m = unode_alloc();
+    m->count = ULIST_NODE_CAP - half;
+    memcpy(m->values, n->values + half, m->count * sizeof(elem));
+    n->count = half;
+    m->next = n->next;
+    n->next = m;
+    if (l->tail == n) l->tail = m;
+    if (off > half) {
+      n = m;
+      off -= half;
+    }
+  }
+  memmove(n->values + off + 1, n->values + off, (n->count - off) * sizeof(elem));
+  n->values[off] = value;
+  n->count++;
+  l->length++;
+}
+
+/* Removes slot off of n. Empty nodes are unlinked, and a node that drops
+ * below half full absorbs its successor when both fit in one node. */
+static elem unode_remove(ulist_t* l, unode_t* prev, unode_t* n, int off) {
+  elem val = n->values[off];
+  n->count--;
+  memmove(n->values + off, n->values + off + 1, (n->count - off) * sizeof(elem));
+  l->length--;
+
+  if (n->count == 0) {
+    if (prev) prev->next = n->next;
+    else l->head = n->next;
+    if (l->tail == n) l->tail = prev;
+    free(n);
+    return val;
+  }
+
+  unode_t* next = n->next;
+  if (next && n->count < ULIST_NODE_CAP / 2 &&
+      n->count + next->count <= ULIST_NODE_CAP) {
+    memcpy(n->values + n->count, next->values, next->count * sizeof(elem));
+    n->count += next->count;
+    n->next = next->next;
+    if (l->tail == next) l->tail = n;
+    free(next);
+  }
+  return val;
+}
+
+ulist_t* ulist_alloc() {
+  ulist_t* l = malloc(sizeof(ulist_t));
+  l->head = NULL;
+  l->tail = NULL;
+  l->length = 0;
+  return l;
+}
+
+void ulist_free(ulist_t* l) {
+  if (!l) return;
+  unode_t* curr = l->head;
+  while (curr) {
+    unode_t* tmp = curr;
+    curr = curr->next;
+    free(tmp);
+  }
+  free(l);
+}
+
+void ulist_print(ulist_t* l) {
+  if (!l) return;
+  for (unode_t* curr = l->head; curr; curr = curr->next) {
+    for (int i = 0; i < curr->count; i++) {
+      printf("%d ", curr->values[i]);
+    }
+  }
+  printf("\n");
+}
+
+char* ulistToString(ulist_t* l) {
+  if (!l) return NULL;
+
+  /* at most 11 digits plus "->" per element, then "NULL" */
+  char* buffer = malloc((size_t)l->length * 13 + 5);
+  char* cursor = buffer;
+
+  for (unode_t* curr = l->head; curr; curr = curr->next) {
+    for (int i = 0; i < curr->count; i++) {
+      cursor += sprintf(cursor, "%d->", curr->values[i]);
+    }
+  }
+
+  strcpy(cursor, "NULL");
+  return buffer;
+}
+
+int ulist_length(ulist_t* l) {
+  return l->length;
+}
+
+void ulist_add_to_back(ulist_t* l, elem value) {
+  /* append-only workloads fill nodes completely instead of splitting */
+  if (!l->tail || l->tail->count == ULIST_NODE_CAP) {
+    unode_t* n = unode_alloc();
+    if (l->tail) l->tail->next = n;
+    else l->head = n;
+    l->tail = n;
+  }
+  l->tail->values[l->tail->count++] = value;
+  l->length++;
+}
+
+void ulist_add_to_front(ulist_t* l, elem value) {
+  if (!l->head) {
+    ulist_add_to_back(l, value);
+    return;
+  }
+  unode_insert(l, l->head, 0, value);
+}
+
+void ulist_add_at_index(ulist_t* l, elem value, int index) {
+  if (!l) return;
+  if (index <= 0 || !l->head) {
+    ulist_add_to_front(l, value);
+    return;
+  }
+  if (index >= l->length) {
+    ulist_add_to_back(l, value);
+    return;
+  }
+
+  int off;
+  unode_t* n = ulist_locate(l, index, NULL, &off);
+  unode_insert(l, n, off, value);
+}
+
+elem ulist_remove_from_back(ulist_t* l) {
+  if (!l || !l->head) return -1;
+  return ulist_remove_at_index(l, l->length - 1);
+}
+
+elem ulist_remove_from_front(ulist_t* l) {
+  if (!l || !l->head) return -1;
+  return unode_remove(l, NULL, l->head, 0);
+}
+
+elem ulist_remove_at_index(ulist_t* l, int index) {
+  if (!l || !l->head) return -1;
+  if (index <= 0) return ulist_remove_from_front(l);
+  if (index >= l->length) return -1;
+
+  int off;
+  unode_t* prev;
+  unode_t* n = ulist_locate(l, index, &prev, &off);
+  return unode_remove(l, prev, n, off);
+}
+
+bool ulist_is_in(ulist_t* l, elem value) {
+  return ulist_get_index_of(l, value) != -1;
+}
+
+elem ulist_get_elem_at(ulist_t* l, int index) {
+  if (!l || index < 0 || index >= l->length) return -1;
+  int off;
+  unode_t* n = ulist_locate(l, index, NULL, &off);
+  return n->values[off];
+}
+
+int ulist_get_index_of(ulist_t* l, elem value) {
+  int base = 0;
+  for (unode_t* curr = l->head; curr; curr = curr->next) {
+    for (int i = 0; i < curr->count; i++) {
+      if (curr->values[i] == value) return base + i;
+    }
+    base += curr->count;
+  }
+  return -1;
+}
@@ -0,0 +1,57 @@
+// list/ulist.h
+//
+// Interface definition for the unrolled linked list. It offers the same
+// operations as list.h with the same index and error semantics, but each
+// node stores up to ULIST_NODE_CAP elements contiguously so that scans and
+// index lookups touch far fewer cache lines.
+//
+// <Author>
+
+#ifndef ULIST_H
+#define ULIST_H
+
+#include <stdbool.h>
+#include "list.h"
+
+/* Number of elements per node. With 4-byte elements the node is exactly
+ * 128 bytes (two cache lines). */
+#define ULIST_NODE_CAP 29
+
+/* Defines the unrolled node. values[0..count-1] hold the elements of this
+ * node in list order; count is never 0 for a node that is linked in. */
+struct unode {
+	struct unode *next;
+	int count;
+	elem values[ULIST_NODE_CAP];
+};
+typedef struct unode unode_t;
+
+/* Defines the unrolled list, with the same cached tail and length as list_t. */
+struct ulist {
+	unode_t *head;
+	unode_t *tail;
+	int length;
+};
+typedef struct ulist ulist_t;
+
+ulist_t *ulist_alloc();
+void ulist_free(ulist_t *l);
+
+void ulist_print(ulist_t *l);
+char* ulistToString(ulist_t *l);
+
+int ulist_length(ulist_t *l);
+
+void ulist_add_to_back(ulist_t *l, elem value);
+void ulist_add_to_front(ulist_t *l, elem value);
+void ulist_add_at_index(ulist_t *l, elem value, int index);
+
+elem ulist_remove_from_back(ulist_t *l);
+elem ulist_remove_from_front(ulist_t *l);
+elem ulist_remove_at_index(ulist_t *l, int index);
+
+bool ulist_is_in(ulist_t *l, elem value);
+elem ulist_get_elem_at(ulist_t *l, int index);
+int ulist_get_index_of(ulist_t *l, elem value);
+
+#endif // ULIST_H
@@ -65,7 +65,28 @@ int main(int argc, char const* argv[])
 					printf("COMMANDS:\n---------\n1. print\n2. get_length\n3. add_back <value>\n4. add_front <value>\n5. add_position <index> <value>\n6. remove_back\n7. remove_front\n8. remove_position <index>\n9. get <index>\n10. exit\n");
 				}
  
-        recv(sockID, responeData, sizeof(responeData), 0); // receive response from server
+				if(strcmp(token,"print") == 0){
+					// the list arrives in chunks and always ends with "NULL"
+					// the terminator may straddle two recv calls, so keep the last 4 bytes
+					char tail[9] = "";
+					int n, t;
+					printf("\nSERVER RESPONSE: ");
+					do {
+						n = recv(sockID, responeData, sizeof(responeData) - 1, 0);
+						if (n <= 0) break;
+						responeData[n] = '\0';
+						fputs(responeData, stdout);
+						strncat(tail, responeData + (n > 4 ? n - 4 : 0), 4);
+						t = strlen(tail);
+						if (t > 4) memmove(tail, tail + t - 4, 5);
+					} while (strcmp(tail, "NULL") != 0);
+					printf("\n");
+					memset(buf, '\0', MAX_COMMAND_LINE_LEN);
+					continue;
+				}
+
+        memset(responeData, '\0', sizeof(responeData));
+        recv(sockID, responeData, sizeof(responeData) - 1, 0); // receive response from server
   
         printf("\nSERVER RESPONSE: %s\n", responeData); 
 				memset(buf, '\0', MAX_COMMAND_LINE_LEN);
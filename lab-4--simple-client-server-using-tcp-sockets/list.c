@@ -132,17 +132,47 @@ int list_get_elem_at(list_t *list, int index) {
     return current->data;
 }
 
-// Convert list to string
-char* listToString(list_t *list) {
-    static char str[1024];
-    str[0] = '\0';
+// Stream the list through w, flushing whenever the chunk fills up
+int list_write(list_t *list, list_writer w, void *ctx) {
+    char chunk[LIST_WRITE_CHUNK];
+    size_t used = 0;
+    int rc;
     node_t *current = list->head;
     while (current != NULL) {
-        char buf[32];
-        sprintf(buf, "%d -> ", current->data);
-        strcat(str, buf);
+        // an int plus " -> " needs at most 15 bytes
+        if (used + 16 > sizeof(chunk)) {
+            if ((rc = w(ctx, chunk, used)) != 0) return rc;
+            used = 0;
+        }
+        used += sprintf(chunk + used, "%d -> ", current->data);
         current = current->next;
     }
-    strcat(str, "NULL");
+    memcpy(chunk + used, "NULL", 4);
+    return w(ctx, chunk, used + 4);
+}
+
+// Growable buffer behind listToString, kept between calls
+static char *str = NULL;
+static size_t str_len = 0, str_cap = 0;
+
+static int string_writer(void *ctx, const char *chunk, size_t len) {
+    if (str_len + len + 1 > str_cap) {
+        size_t cap = str_cap ? str_cap : 1024;
+        while (str_len + len + 1 > cap) cap *= 2;
+        char *grown = realloc(str, cap);
+        if (grown == NULL) return -1;
+        str = grown;
+        str_cap = cap;
+    }
+    memcpy(str + str_len, chunk, len);
+    str_len += len;
+    str[str_len] = '\0';
+    return 0;
+}
+
+// Convert list to string
+char* listToString(list_t *list) {
+    str_len = 0;
+    if (list_write(list, string_writer, NULL) != 0) return NULL;
     return str;
 }
@@ -44,7 +44,15 @@ int list_remove_at_index(list_t *list, int index);
 // Get element at a specific index
 int list_get_elem_at(list_t *list, int index);
 
-// Convert list to string
+// Convert list to string (points to an internal buffer reused by each call)
 char* listToString(list_t *list);
 
+// Chunked output callback for list_write; a non-zero return stops the write
+typedef int (*list_writer)(void *ctx, const char *chunk, size_t len);
+
+// Stream the listToString text through w in chunks of at most
+// LIST_WRITE_CHUNK bytes, without building the whole string
+#define LIST_WRITE_CHUNK 1024
+int list_write(list_t *list, list_writer w, void *ctx);
+
 #endif
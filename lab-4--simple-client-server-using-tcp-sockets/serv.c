@@ -15,6 +15,18 @@ int serverSocket = -1;
 int clientSocket = -1;
 list_t *mylist = NULL;
 
+// list_writer that sends each chunk to the socket passed as ctx
+int socket_writer(void *ctx, const char *chunk, size_t len) {
+    int sock = *(int *)ctx;
+    while (len > 0) {
+        ssize_t sent = send(sock, chunk, len, 0);
+        if (sent <= 0) return -1;
+        chunk += sent;
+        len -= sent;
+    }
+    return 0;
+}
+
 // Graceful exit handler
 void handle_exit(int sig) {
     if (mylist) list_free(mylist);
@@ -138,7 +150,10 @@ int main(int argc, char const* argv[]) {
             sprintf(sendBuf, "Value at %d = %d", idx, val);
         }
         else if (strcmp(token, "print") == 0) {
-            sprintf(sendBuf, "%s", listToString(mylist));
+            // stream straight to the socket; the reply ends with "NULL"
+            list_write(mylist, socket_writer, &clientSocket);
+            memset(recvBuf, '\0', sizeof(recvBuf));
+            continue;
         }
         else {
             sprintf(sendBuf, "Invalid command");
@@ -0,0 +1,46 @@
+#!/bin/sh
+# Runs every policy on generated traces of growing size and prints the
+# wall-clock time and peak RSS of each run. Sizes, the seed, extra tracegen
+# options and a trace directory come from the environment, e.g.
+#   BENCH_SIZES="10000 100000" BENCH_GEN="--burst=pareto:1.5:2" sh bench.sh
+# Traces go to a fresh temporary directory that is removed afterwards. With
+# BENCH_DIR set they are kept there and reused by later runs; the file name
+# carries the size, seed and tracegen options, so changing any of them
+# generates a new trace. Runs the -O2 build from "make schedsim_bench"; run
+# from the SchedSim directory.
+
+sizes=${BENCH_SIZES:-"10000 1000000 10000000"}
+seed=${BENCH_SEED:-1}
+gen=${BENCH_GEN:-}
+if [ -n "$BENCH_DIR" ]; then
+    dir=$BENCH_DIR
+    mkdir -p "$dir" || exit 1
+else
+    dir=$(mktemp -d) || exit 1
+    trap 'rm -rf "$dir"' EXIT
+fi
+# tracegen options reduced to a file name fragment
+tag=$(printf '%s' "$gen" | tr -c 'A-Za-z0-9.:' '_')
+policies="fcfs sjf priority rr mlfq cfs"
+status=0
+
+printf "%-10s %-10s %10s %14s\n" processes policy wall_s peak_rss_kb
+for n in $sizes; do
+    trace=$dir/schedsim_bench_${n}_s$seed${tag:+_$tag}.bin
+    if [ ! -f "$trace" ]; then
+        ./tracegen --count=$n --seed=$seed --binary $gen --output="$trace" || exit 1
+    fi
+    for p in $policies; do
+        stat=$(./runstat ./schedsim_bench --binary -p $p --format=csv "$trace" 2>&1 >/dev/null |
+            grep '^wall_s=')
+        if [ -z "$stat" ]; then
+            echo "FAIL $p on $n processes"
+            status=1
+            continue
+        fi
+        wall=$(echo "$stat" | sed 's/.*wall_s=\([^ ]*\).*/\1/')
+        rss=$(echo "$stat" | sed 's/.*peak_rss_kb=\([^ ]*\).*/\1/')
+        printf "%-10s %-10s %10s %14s\n" $n $p $wall $rss
+    done
+done
+exit $status
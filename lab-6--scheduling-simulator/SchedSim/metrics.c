@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "metrics.h"
+#include "sched.h"
+
+#define RADIX_BITS 16
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+// LSD radix sort of n ints in two 16-bit passes; tmp holds n ints. Much
+// faster than qsort on the millions of values of a big trace.
+static void radix_sort(int v[], int tmp[], int n)
+{
+    int *count = (int *) xmalloc((RADIX_SIZE + 1) * sizeof(int), "radix_sort");
+    int *src = v, *dst = tmp;
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        for (int b = 0; b <= RADIX_SIZE; b++)
+            count[b] = 0;
+        // flipping the sign bit orders negative values first
+        for (int i = 0; i < n; i++)
+            count[((((unsigned)src[i]) ^ 0x80000000u) >> shift & (RADIX_SIZE - 1)) + 1]++;
+        for (int b = 0; b < RADIX_SIZE; b++)
+            count[b + 1] += count[b];
+        for (int i = 0; i < n; i++)
+            dst[count[(((unsigned)src[i]) ^ 0x80000000u) >> shift & (RADIX_SIZE - 1)]++] = src[i];
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    // an even number of passes leaves the result in v
+    free(count);
+}
+
+// Nearest-rank percentile of the n sorted values
+static int percentile(const int sorted[], int n, int p)
+{
+    long long rank = ((long long)p * n + 99) / 100;
+    return n > 0 ? sorted[rank > 0 ? rank - 1 : 0] : 0;
+}
+
+static void compute_spread(const int v[], int n, SpreadType *s)
+{
+    int *sorted = (int *) xmalloc(2 * (size_t)n * sizeof(int), "compute_spread");
+    long long total = 0;
+
+    for (int i = 0; i < n; i++) {
+        sorted[i] = v[i];
+        total += v[i];
+    }
+    radix_sort(sorted, sorted + n, n);
+    s->avg = n > 0 ? (double)total / n : 0.0;
+    s->p50 = percentile(sorted, n, 50);
+    s->p90 = percentile(sorted, n, 90);
+    s->p99 = percentile(sorted, n, 99);
+    s->max = n > 0 ? sorted[n - 1] : 0;
+    free(sorted);
+}
+
+void compute_metrics(const ProcessType plist[], const ResultType *res, int n, MetricsType *m)
+{
+    long long busy = 0;
+    double sum = 0.0, sum_sq = 0.0;
+
+    compute_spread(res->wt, n, &m->wt);
+    compute_spread(res->tat, n, &m->tat);
+    compute_spread(res->rt, n, &m->rt);
+
+    for (int c = 0; c < res->ncpus; c++)
+        busy += res->cpu[c].busy;
+    m->throughput = res->makespan > 0 ? (double)n / res->makespan : 0.0;
+    m->utilization = res->makespan > 0 ? (double)busy / ((double)res->ncpus * res->makespan) : 0.0;
+
+    // Jain's index over the share of its turnaround each process ran for
+    for (int i = 0; i < n; i++) {
+        double x = res->tat[i] > 0 ? (double)plist[i].bt / res->tat[i] : 1.0;
+        sum += x;
+        sum_sq += x * x;
+    }
+    m->fairness = sum_sq > 0 ? sum * sum / (n * sum_sq) : 1.0;
+}
+
+static void print_spread(const char *what, const SpreadType *s)
+{
+    printf("\n%s p50/p90/p99/max = %d/%d/%d/%d", what, s->p50, s->p90, s->p99, s->max);
+}
+
+// Print metrics
+void printMetrics(const ProcessType plist[], const ResultType *res, int n, const MetricsType *m)
+{
+    printf("\tProcesses\tBurst time\tWaiting time\tTurn around time\n");
+    for (int k = 0; k < n; k++) {
+        int i = res->order ? res->order[k] : k;
+        printf("\t%d\t\t%d\t\t%d\t\t%d\n", plist[i].pid, plist[i].bt, res->wt[i], res->tat[i]);
+    }
+
+    printf("\nAverage waiting time = %.2f", m->wt.avg);
+    printf("\nAverage turn around time = %.2f", m->tat.avg);
+    printf("\nAverage response time = %.2f", m->rt.avg);
+    print_spread("Waiting time", &m->wt);
+    print_spread("Turn around time", &m->tat);
+    print_spread("Response time", &m->rt);
+    printf("\nThroughput = %.4f processes per time unit", m->throughput);
+    printf("\nCPU utilization = %.2f%%", 100.0 * m->utilization);
+    printf("\nContext switches = %lld", res->switches);
+    printf("\nJain's fairness index = %.4f\n", m->fairness);
+}
+
+// Print per-CPU utilization, migrations and load imbalance of a --cpus run
+void printCpuMetrics(const ResultType *res)
+{
+    long long total_busy = 0, max_busy = 0;
+    int migrations = 0;
+
+    printf("\n\tCPU\tBusy time\tUtilization\tCompleted\tStolen\n");
+    for (int c = 0; c < res->ncpus; c++) {
+        const CpuStatsType *cpu = &res->cpu[c];
+        total_busy += cpu->busy;
+        if (cpu->busy > max_busy)
+            max_busy = cpu->busy;
+        migrations += cpu->stolen;
+        printf("\t%d\t%lld\t\t%.2f%%\t\t%d\t\t%d\n", c, cpu->busy,
+               res->makespan > 0 ? 100.0 * cpu->busy / res->makespan : 0.0,
+               cpu->completed, cpu->stolen);
+    }
+
+    // busiest CPU over the mean: 0% when the work is spread evenly
+    double mean_busy = (double)total_busy / res->ncpus;
+    printf("\nMigrations = %d", migrations);
+    printf("\nLoad imbalance = %.2f%%\n",
+           mean_busy > 0 ? 100.0 * (max_busy / mean_busy - 1.0) : 0.0);
+}
+
+void print_report_begin(OutputFormat format)
+{
+    if (format == FORMAT_CSV)
+        printf("policy,title,processes,cpus,makespan,"
+               "avg_wt,p50_wt,p90_wt,p99_wt,max_wt,"
+               "avg_tat,p50_tat,p90_tat,p99_tat,max_tat,"
+               "avg_rt,p50_rt,p90_rt,p99_rt,max_rt,"
+               "throughput,utilization,context_switches,migrations,fairness\n");
+    else if (format == FORMAT_JSON)
+        printf("[");
+}
+
+static void print_csv_spread(const SpreadType *s)
+{
+    printf(",%.2f,%d,%d,%d,%d", s->avg, s->p50, s->p90, s->p99, s->max);
+}
+
+static void print_json_spread(const char *key, const SpreadType *s)
+{
+    printf(",\n    \"%s\": {\"avg\": %.2f, \"p50\": %d, \"p90\": %d, \"p99\": %d, \"max\": %d}",
+           key, s->avg, s->p50, s->p90, s->p99, s->max);
+}
+
+// One run as a JSON object: summary, per-CPU counters and per-process rows
+static void print_json_run(const char *name, const char *title, const ProcessType plist[],
+                           const ResultType *res, int n, const MetricsType *m)
+{
+    printf("  {\n    \"policy\": \"%s\",\n    \"title\": \"%s\"", name, title);
+    printf(",\n    \"processes\": %d,\n    \"cpus\": %d,\n    \"makespan\": %lld",
+           n, res->ncpus, res->makespan);
+    print_json_spread("wt", &m->wt);
+    print_json_spread("tat", &m->tat);
+    print_json_spread("rt", &m->rt);
+    printf(",\n    \"throughput\": %.6f,\n    \"utilization\": %.6f", m->throughput, m->utilization);
+    printf(",\n    \"context_switches\": %lld,\n    \"fairness\": %.6f", res->switches, m->fairness);
+
+    printf(",\n    \"per_cpu\": [");
+    for (int c = 0; c < res->ncpus; c++)
+        printf("%s\n      {\"cpu\": %d, \"busy\": %lld, \"completed\": %d, \"stolen\": %d}",
+               c ? "," : "", c, res->cpu[c].busy, res->cpu[c].completed, res->cpu[c].stolen);
+    printf("\n    ]");
+
+    printf(",\n    \"per_process\": [");
+    for (int k = 0; k < n; k++) {
+        int i = res->order ? res->order[k] : k;
+        printf("%s\n      {\"pid\": %d, \"bt\": %d, \"art\": %d, \"pri\": %d, \"wt\": %d, \"tat\": %d, \"rt\": %d}",
+               k ? "," : "", plist[i].pid, plist[i].bt, plist[i].art, plist[i].pri,
+               res->wt[i], res->tat[i], res->rt[i]);
+    }
+    printf("\n    ]\n  }");
+}
+
+void print_report(OutputFormat format, const char *name, const char *title,
+                  const ProcessType plist[], const ResultType *res, int n,
+                  const MetricsType *m, int first)
+{
+    switch (format) {
+    case FORMAT_TEXT:
+        printf("\n*********\n%s\n", title);
+        printMetrics(plist, res, n, m);
+        if (res->ncpus > 1)
+            printCpuMetrics(res);
+        break;
+    case FORMAT_CSV: {
+        int migrations = 0;
+        for (int c = 0; c < res->ncpus; c++)
+            migrations += res->cpu[c].stolen;
+        printf("%s,\"%s\",%d,%d,%lld", name, title, n, res->ncpus, res->makespan);
+        print_csv_spread(&m->wt);
+        print_csv_spread(&m->tat);
+        print_csv_spread(&m->rt);
+        printf(",%.6f,%.6f,%lld,%d,%.6f\n", m->throughput, m->utilization, res->switches,
+               migrations, m->fairness);
+        break;
+    }
+    case FORMAT_JSON:
+        printf("%s\n", first ? "" : ",");
+        print_json_run(name, title, plist, res, n, m);
+        break;
+    }
+}
+
+void print_report_end(OutputFormat format)
+{
+    if (format == FORMAT_JSON)
+        printf("\n]\n");
+}
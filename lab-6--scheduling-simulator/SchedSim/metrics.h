@@ -0,0 +1,48 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "process.h"
+
+/**
+ * Summary metrics of one policy run and the report printers (text table,
+ * CSV, JSON). Totals are accumulated in 64 bits.
+ */
+
+// Distribution of one per-process time over all processes
+typedef struct Spread {
+    double avg;
+    int p50, p90, p99, max; // nearest-rank percentiles
+} SpreadType;
+
+typedef struct Metrics {
+    SpreadType wt; // waiting time
+    SpreadType tat; // turnaround time
+    SpreadType rt; // response time
+    double throughput; // processes finished per time unit
+    double utilization; // busy time over ncpus * makespan
+    double fairness; // Jain's index of bt/tat, 1 when all are equal
+} MetricsType;
+
+typedef enum OutputFormat {
+    FORMAT_TEXT,
+    FORMAT_CSV,
+    FORMAT_JSON
+} OutputFormat;
+
+void compute_metrics(const ProcessType plist[], const ResultType *res, int n, MetricsType *m);
+
+// Text report: the per-process table followed by the summary lines
+void printMetrics(const ProcessType plist[], const ResultType *res, int n, const MetricsType *m);
+
+// Text report of the per-CPU counters of a --cpus run
+void printCpuMetrics(const ResultType *res);
+
+// A report is begin, one print_report per policy run, then end. m comes
+// from compute_metrics, which the policy threads run in parallel.
+void print_report_begin(OutputFormat format);
+void print_report(OutputFormat format, const char *name, const char *title,
+                  const ProcessType plist[], const ResultType *res, int n,
+                  const MetricsType *m, int first);
+void print_report_end(OutputFormat format);
+
+#endif				// METRICS_H
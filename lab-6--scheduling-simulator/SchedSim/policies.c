@@ -0,0 +1,214 @@
+// Scheduler policies and the registry that --policy selects from.
+//
+// To add a policy, define a Policy (in its own file if it is large) and
+// list it in policy_table below; main needs no changes.
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched.h"
+#include "pqueue.h"
+
+// Cursor over a fixed run order, for the non-preemptive policies
+typedef struct OrderState {
+    int *order; // plist indices in run order
+    int next;
+} OrderState;
+
+static int order_pick_next(SimCtx *ctx, long long *slice)
+{
+    OrderState *s = (OrderState *)ctx->state;
+    (void)slice; // run to completion
+    return s->next < ctx->n ? s->order[s->next++] : -1;
+}
+
+static void order_on_tick(SimCtx *ctx, int i, long long ran)
+{
+    // never called: these policies always run to completion
+    (void)ctx;
+    (void)i;
+    (void)ran;
+}
+
+// FCFS: processes run to completion in input file order
+static void fcfs_init(SimCtx *ctx)
+{
+    OrderState *s = (OrderState *) xmalloc(sizeof(OrderState), "fcfs_init");
+    s->order = (int *) xmalloc(ctx->n * sizeof(int), "fcfs_init");
+    for (int i = 0; i < ctx->n; i++)
+        s->order[i] = i;
+    s->next = 0;
+    ctx->state = s;
+}
+
+static void fcfs_fini(SimCtx *ctx)
+{
+    OrderState *s = (OrderState *)ctx->state;
+    free(s->order);
+    free(s);
+}
+
+const Policy policy_fcfs = {
+    "fcfs", "FCFS", 0,
+    fcfs_init, order_pick_next, NULL, order_on_tick, NULL, fcfs_fini, NULL
+};
+
+// Priority: processes run to completion, largest pri first. The run order
+// is also the print order, so res->order keeps it (and frees it).
+static void priority_init(SimCtx *ctx)
+{
+    OrderState *s = (OrderState *) xmalloc(sizeof(OrderState), "priority_init");
+    s->order = priority_order(ctx->plist, ctx->n);
+    s->next = 0;
+    ctx->res->order = s->order;
+    ctx->state = s;
+}
+
+static void priority_fini(SimCtx *ctx)
+{
+    free(ctx->state);
+}
+
+const Policy policy_priority = {
+    "priority", "Priority", 0,
+    priority_init, order_pick_next, NULL, order_on_tick, NULL, priority_fini, NULL
+};
+
+// SRTF (preemptive SJF): a min-heap of ready processes keyed by remaining
+// time, ties to the lower index. The running process is out of the heap
+// and goes back in with its new remaining time after every slice, so an
+// arrival with a shorter job takes over. Each CPU has its own heap.
+static void sjf_init(SimCtx *ctx)
+{
+    PQueue *ready = (PQueue *) xmalloc(sizeof(PQueue), "sjf_init");
+    pq_init(ready, ctx->n / ctx->ncpus);
+    ctx->state = ready;
+}
+
+static int sjf_pick_next(SimCtx *ctx, long long *slice)
+{
+    PQueue *ready = (PQueue *)ctx->state;
+    (void)slice; // runs until done or the next arrival
+    return ready->size > 0 ? pq_pop(ready).id : -1;
+}
+
+static void sjf_on_arrival(SimCtx *ctx, int i)
+{
+    pq_push((PQueue *)ctx->state, ctx->rem[i], i);
+}
+
+static void sjf_on_tick(SimCtx *ctx, int i, long long ran)
+{
+    (void)ran;
+    pq_push((PQueue *)ctx->state, ctx->rem[i], i);
+}
+
+static void sjf_fini(SimCtx *ctx)
+{
+    pq_free((PQueue *)ctx->state);
+    free(ctx->state);
+}
+
+static int sjf_steal(SimCtx *to, SimCtx *from)
+{
+    PQueue *victim = (PQueue *)from->state;
+    PQEntry e;
+
+    if (victim->size == 0)
+        return -1;
+    e = pq_pop(victim);
+    pq_push((PQueue *)to->state, e.key, e.id);
+    return e.id;
+}
+
+const Policy policy_sjf = {
+    "sjf", "SJF (Preemptive/SRTF)", 1,
+    sjf_init, sjf_pick_next, sjf_on_arrival, sjf_on_tick, NULL, sjf_fini, sjf_steal
+};
+
+// RR: FIFO ready queue per CPU, linked through a next[] array shared by
+// all CPUs (each process is in at most one queue). A process whose quantum
+// expires goes to the back, behind the processes that arrived while it ran.
+typedef struct RRState {
+    int *next; // per process: next in its queue, -1 at the tail (shared)
+    int head; // -1 when empty
+    int tail;
+} RRState;
+
+static void rr_init(SimCtx *ctx)
+{
+    RRState *s = (RRState *) xmalloc(sizeof(RRState), "rr_init");
+    if (ctx->cpu == 0)
+        ctx->shared = xmalloc(ctx->n * sizeof(int), "rr_init");
+    s->next = (int *)ctx->shared;
+    s->head = s->tail = -1;
+    ctx->state = s;
+}
+
+static void rr_enqueue(SimCtx *ctx, int i)
+{
+    RRState *s = (RRState *)ctx->state;
+    s->next[i] = -1;
+    if (s->tail < 0)
+        s->head = i;
+    else
+        s->next[s->tail] = i;
+    s->tail = i;
+}
+
+static int rr_dequeue(RRState *s)
+{
+    int i = s->head;
+    if (i >= 0) {
+        s->head = s->next[i];
+        if (s->head < 0)
+            s->tail = -1;
+    }
+    return i;
+}
+
+static int rr_pick_next(SimCtx *ctx, long long *slice)
+{
+    int i = rr_dequeue((RRState *)ctx->state);
+    if (i >= 0)
+        *slice = ctx->params->quantum;
+    return i;
+}
+
+static void rr_on_tick(SimCtx *ctx, int i, long long ran)
+{
+    (void)ran;
+    rr_enqueue(ctx, i);
+}
+
+static void rr_fini(SimCtx *ctx)
+{
+    if (ctx->cpu == 0)
+        free(ctx->shared);
+    free(ctx->state);
+}
+
+static int rr_steal(SimCtx *to, SimCtx *from)
+{
+    int i = rr_dequeue((RRState *)from->state);
+    if (i >= 0)
+        rr_enqueue(to, i);
+    return i;
+}
+
+const Policy policy_rr = {
+    "rr", "RR Quantum = %d", 0,
+    rr_init, rr_pick_next, rr_enqueue, rr_on_tick, NULL, rr_fini, rr_steal
+};
+
+extern const Policy policy_mlfq; // policy_mlfq.c
+extern const Policy policy_cfs; // policy_cfs.c
+
+const Policy *const policy_table[] = {
+    &policy_fcfs,
+    &policy_sjf,
+    &policy_priority,
+    &policy_rr,
+    &policy_mlfq,
+    &policy_cfs,
+    NULL
+};
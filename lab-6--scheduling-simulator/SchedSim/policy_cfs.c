@@ -0,0 +1,143 @@
+// CFS-style fair scheduling
+//
+// Ready processes sit in a min-heap keyed on virtual runtime: the time
+// they have run, scaled down by their weight. The process that has had
+// the least weighted CPU time runs next, for a slice proportional to its
+// share of the total runnable weight over one scheduling period.
+//
+// Weights follow the Linux nice table with nice = -pri, so a larger pri
+// gets more CPU, as in Priority scheduling. A newly arrived process starts
+// at the current minimum vruntime so it cannot starve the others. There
+// is no wakeup preemption: an arrival waits for the running slice, which
+// the period already keeps short. With several CPUs each has its own heap
+// and min_vruntime; a stolen process keeps its lag behind the old CPU's
+// min_vruntime on the new one.
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched.h"
+#include "pqueue.h"
+
+#define CFS_NICE_0_WEIGHT 1024
+// vruntime is kept in 1/CFS_VR_SCALE time units so heavy weights still
+// advance it on a 1 unit slice
+#define CFS_VR_SCALE 1024
+
+static const int cfs_prio_to_weight[40] = {
+    /* -20 */ 88761, 71755, 56483, 46273, 36291,
+    /* -15 */ 29154, 23254, 18705, 14949, 11916,
+    /* -10 */ 9548, 7620, 6100, 4904, 3906,
+    /*  -5 */ 3121, 2501, 1991, 1586, 1277,
+    /*   0 */ 1024, 820, 655, 526, 423,
+    /*   5 */ 335, 272, 215, 172, 137,
+    /*  10 */ 110, 87, 70, 56, 45,
+    /*  15 */ 36, 29, 23, 18, 15,
+};
+
+typedef struct CFSState {
+    PQueue ready; // keyed on vruntime
+    long long *vruntime; // per process, shared by all CPUs
+    long long min_vruntime; // never decreases
+    long long total_weight; // of the runnable processes, running included
+    int nr_running;
+} CFSState;
+
+static int cfs_weight(const ProcessType *p)
+{
+    int nice = -p->pri;
+    if (nice < -20)
+        nice = -20;
+    if (nice > 19)
+        nice = 19;
+    return cfs_prio_to_weight[nice + 20];
+}
+
+static void cfs_init(SimCtx *ctx)
+{
+    CFSState *s = (CFSState *) xmalloc(sizeof(CFSState), "cfs_init");
+    pq_init(&s->ready, ctx->n / ctx->ncpus);
+    if (ctx->cpu == 0)
+        ctx->shared = xmalloc(ctx->n * sizeof(long long), "cfs_init");
+    s->vruntime = (long long *)ctx->shared;
+    s->min_vruntime = 0;
+    s->total_weight = 0;
+    s->nr_running = 0;
+    ctx->state = s;
+}
+
+static void cfs_on_arrival(SimCtx *ctx, int i)
+{
+    CFSState *s = (CFSState *)ctx->state;
+    s->vruntime[i] = s->min_vruntime;
+    s->total_weight += cfs_weight(&ctx->plist[i]);
+    s->nr_running++;
+    pq_push(&s->ready, s->vruntime[i], i);
+}
+
+static int cfs_pick_next(SimCtx *ctx, long long *slice)
+{
+    CFSState *s = (CFSState *)ctx->state;
+    long long period = ctx->params->cfs_latency;
+    int i;
+
+    if (s->ready.size == 0)
+        return -1;
+    i = pq_pop(&s->ready).id;
+    if (s->vruntime[i] > s->min_vruntime)
+        s->min_vruntime = s->vruntime[i];
+
+    // the period stretches so no slice is shorter than the granularity
+    if ((long long)s->nr_running * ctx->params->cfs_min_gran > period)
+        period = (long long)s->nr_running * ctx->params->cfs_min_gran;
+    *slice = period * cfs_weight(&ctx->plist[i]) / s->total_weight;
+    if (*slice < 1)
+        *slice = 1;
+    return i;
+}
+
+static void cfs_on_tick(SimCtx *ctx, int i, long long ran)
+{
+    CFSState *s = (CFSState *)ctx->state;
+    s->vruntime[i] += ran * CFS_NICE_0_WEIGHT * CFS_VR_SCALE / cfs_weight(&ctx->plist[i]);
+    pq_push(&s->ready, s->vruntime[i], i);
+}
+
+static void cfs_on_complete(SimCtx *ctx, int i)
+{
+    CFSState *s = (CFSState *)ctx->state;
+    s->total_weight -= cfs_weight(&ctx->plist[i]);
+    s->nr_running--;
+}
+
+static void cfs_fini(SimCtx *ctx)
+{
+    CFSState *s = (CFSState *)ctx->state;
+    pq_free(&s->ready);
+    if (ctx->cpu == 0)
+        free(ctx->shared);
+    free(s);
+}
+
+static int cfs_steal(SimCtx *to, SimCtx *from)
+{
+    CFSState *src = (CFSState *)from->state;
+    CFSState *dst = (CFSState *)to->state;
+    int i, w;
+
+    if (src->ready.size == 0)
+        return -1;
+    i = pq_pop(&src->ready).id;
+    w = cfs_weight(&from->plist[i]);
+    src->total_weight -= w;
+    src->nr_running--;
+    dst->total_weight += w;
+    dst->nr_running++;
+    src->vruntime[i] += dst->min_vruntime - src->min_vruntime;
+    pq_push(&dst->ready, src->vruntime[i], i);
+    return i;
+}
+
+const Policy policy_cfs = {
+    "cfs", "CFS", 0,
+    cfs_init, cfs_pick_next, cfs_on_arrival, cfs_on_tick, cfs_on_complete, cfs_fini, cfs_steal
+};
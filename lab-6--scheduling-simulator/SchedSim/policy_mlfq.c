@@ -0,0 +1,209 @@
+// Multi-Level Feedback Queue
+//
+// Level 0 is the highest priority. A new process enters level 0 and drops
+// one level each time it uses up that level's allotment; the bottom level
+// is plain RR. An arrival preempts the running slice, and the preempted
+// process resumes first in its level with what is left of its allotment.
+// Every mlfq_boost time units all processes move back to level 0.
+//
+// The queues are intrusive FIFO lists threaded through next[], so a boost
+// splices whole levels in O(levels). Levels are reset lazily: a process
+// whose epoch is older than the current boost epoch is at level 0 with a
+// fresh allotment. With several CPUs each has its own queues and boosts
+// them on the same global schedule; the per-process arrays are shared, so
+// a stolen process keeps its level and allotment.
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "sched.h"
+
+// Per-process data, shared by all CPUs
+typedef struct MLFQProc {
+    int *next; // next in its queue, -1 at the tail
+    int *level; // valid while stamp[i] == epoch
+    long long *used; // time used of its current allotment
+    long long *stamp; // boost epoch of level[] and used[]
+} MLFQProc;
+
+typedef struct MLFQState {
+    int levels;
+    int *head; // per level, -1 when empty
+    int *tail;
+    int *next; // the MLFQProc arrays
+    int *level;
+    long long *used;
+    long long *stamp;
+    long long epoch; // boost interval number of the last boost
+    long long next_boost; // LLONG_MAX when boosting is off
+} MLFQState;
+
+static void mlfq_push_back(MLFQState *s, int lvl, int i)
+{
+    s->next[i] = -1;
+    if (s->tail[lvl] < 0)
+        s->head[lvl] = i;
+    else
+        s->next[s->tail[lvl]] = i;
+    s->tail[lvl] = i;
+}
+
+static void mlfq_push_front(MLFQState *s, int lvl, int i)
+{
+    s->next[i] = s->head[lvl];
+    if (s->head[lvl] < 0)
+        s->tail[lvl] = i;
+    s->head[lvl] = i;
+}
+
+static int mlfq_pop_front(MLFQState *s, int lvl)
+{
+    int i = s->head[lvl];
+    s->head[lvl] = s->next[i];
+    if (s->head[lvl] < 0)
+        s->tail[lvl] = -1;
+    return i;
+}
+
+// Brings level[i] and used[i] up to the current boost epoch
+static void mlfq_refresh(MLFQState *s, int i)
+{
+    if (s->stamp[i] != s->epoch) {
+        s->stamp[i] = s->epoch;
+        s->level[i] = 0;
+        s->used[i] = 0;
+    }
+}
+
+// Appends every lower level to level 0, in level order, if a boost is due
+static void mlfq_boost(MLFQState *s, long long t, int interval)
+{
+    if (t < s->next_boost)
+        return;
+    for (int lvl = 1; lvl < s->levels; lvl++) {
+        if (s->head[lvl] < 0)
+            continue;
+        if (s->tail[0] < 0)
+            s->head[0] = s->head[lvl];
+        else
+            s->next[s->tail[0]] = s->head[lvl];
+        s->tail[0] = s->tail[lvl];
+        s->head[lvl] = s->tail[lvl] = -1;
+    }
+    s->epoch = t / interval;
+    s->next_boost = (s->epoch + 1) * interval;
+}
+
+static void mlfq_init(SimCtx *ctx)
+{
+    MLFQState *s = (MLFQState *) xmalloc(sizeof(MLFQState), "mlfq_init");
+    int levels = ctx->params->mlfq_levels;
+
+    s->levels = levels;
+    s->head = (int *) xmalloc(levels * sizeof(int), "mlfq_init");
+    s->tail = (int *) xmalloc(levels * sizeof(int), "mlfq_init");
+    for (int lvl = 0; lvl < levels; lvl++)
+        s->head[lvl] = s->tail[lvl] = -1;
+    if (ctx->cpu == 0) {
+        MLFQProc *p = (MLFQProc *) xmalloc(sizeof(MLFQProc), "mlfq_init");
+        p->next = (int *) xmalloc(ctx->n * sizeof(int), "mlfq_init");
+        p->level = (int *) xmalloc(ctx->n * sizeof(int), "mlfq_init");
+        p->used = (long long *) xmalloc(ctx->n * sizeof(long long), "mlfq_init");
+        p->stamp = (long long *) xmalloc(ctx->n * sizeof(long long), "mlfq_init");
+        for (int i = 0; i < ctx->n; i++)
+            p->stamp[i] = -1;
+        ctx->shared = p;
+    }
+    s->next = ((MLFQProc *)ctx->shared)->next;
+    s->level = ((MLFQProc *)ctx->shared)->level;
+    s->used = ((MLFQProc *)ctx->shared)->used;
+    s->stamp = ((MLFQProc *)ctx->shared)->stamp;
+    s->epoch = 0;
+    s->next_boost = ctx->params->mlfq_boost > 0 ? ctx->params->mlfq_boost : LLONG_MAX;
+    ctx->state = s;
+}
+
+static void mlfq_on_arrival(SimCtx *ctx, int i)
+{
+    MLFQState *s = (MLFQState *)ctx->state;
+    mlfq_refresh(s, i);
+    mlfq_push_back(s, 0, i);
+}
+
+static int mlfq_pick_next(SimCtx *ctx, long long *slice)
+{
+    MLFQState *s = (MLFQState *)ctx->state;
+    int lvl, i;
+
+    mlfq_boost(s, ctx->t, ctx->params->mlfq_boost);
+    for (lvl = 0; lvl < s->levels && s->head[lvl] < 0; lvl++)
+        ;
+    if (lvl == s->levels)
+        return -1;
+
+    i = mlfq_pop_front(s, lvl);
+    mlfq_refresh(s, i);
+    *slice = ctx->params->mlfq_quanta[s->level[i]] - s->used[i];
+    // stop at the boost so everything waiting is promoted on time
+    if (s->next_boost - ctx->t < *slice)
+        *slice = s->next_boost - ctx->t;
+    return i;
+}
+
+static void mlfq_on_tick(SimCtx *ctx, int i, long long ran)
+{
+    MLFQState *s = (MLFQState *)ctx->state;
+    int lvl = s->level[i];
+
+    s->used[i] += ran;
+    if (s->used[i] >= ctx->params->mlfq_quanta[lvl]) {
+        if (lvl < s->levels - 1)
+            s->level[i] = ++lvl;
+        s->used[i] = 0;
+        mlfq_push_back(s, lvl, i);
+    } else {
+        // preempted by an arrival or a boost: keep its turn
+        mlfq_push_front(s, lvl, i);
+    }
+}
+
+static void mlfq_fini(SimCtx *ctx)
+{
+    MLFQState *s = (MLFQState *)ctx->state;
+    if (ctx->cpu == 0) {
+        free(s->next);
+        free(s->level);
+        free(s->used);
+        free(s->stamp);
+        free(ctx->shared);
+    }
+    free(s->head);
+    free(s->tail);
+    free(s);
+}
+
+// Takes the head of from's highest non-empty level; it keeps its level
+// and what is left of its allotment
+static int mlfq_steal(SimCtx *to, SimCtx *from)
+{
+    MLFQState *src = (MLFQState *)from->state;
+    MLFQState *dst = (MLFQState *)to->state;
+    int lvl, i;
+
+    // bring both CPUs to the same boost epoch first
+    mlfq_boost(src, from->t, from->params->mlfq_boost);
+    mlfq_boost(dst, to->t, to->params->mlfq_boost);
+    for (lvl = 0; lvl < src->levels && src->head[lvl] < 0; lvl++)
+        ;
+    if (lvl == src->levels)
+        return -1;
+    i = mlfq_pop_front(src, lvl);
+    mlfq_refresh(src, i);
+    mlfq_push_back(dst, src->level[i], i);
+    return i;
+}
+
+const Policy policy_mlfq = {
+    "mlfq", "MLFQ", 1,
+    mlfq_init, mlfq_pick_next, mlfq_on_arrival, mlfq_on_tick, NULL, mlfq_fini, mlfq_steal
+};
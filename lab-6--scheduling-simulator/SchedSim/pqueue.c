@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pqueue.h"
+
+static int pq_less(PQEntry *a, PQEntry *b)
+{
+    if (a->key != b->key)
+        return a->key < b->key;
+    return a->id < b->id;
+}
+
+static void pq_sift_up(PQueue *pq, int i)
+{
+    PQEntry e = pq->heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!pq_less(&e, &pq->heap[parent]))
+            break;
+        pq->heap[i] = pq->heap[parent];
+        i = parent;
+    }
+    pq->heap[i] = e;
+}
+
+static void pq_sift_down(PQueue *pq, int i)
+{
+    PQEntry e = pq->heap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= pq->size)
+            break;
+        if (child + 1 < pq->size && pq_less(&pq->heap[child + 1], &pq->heap[child]))
+            child++;
+        if (!pq_less(&pq->heap[child], &e))
+            break;
+        pq->heap[i] = pq->heap[child];
+        i = child;
+    }
+    pq->heap[i] = e;
+}
+
+void pq_init(PQueue *pq, int cap)
+{
+    pq->size = 0;
+    pq->cap = cap > 0 ? cap : 1;
+    pq->heap = (PQEntry *) malloc(pq->cap * sizeof(PQEntry));
+    if (!pq->heap) {
+        fprintf(stderr, "Fatal: malloc failed in pq_init\n");
+        exit(1);
+    }
+}
+
+void pq_free(PQueue *pq)
+{
+    free(pq->heap);
+    pq->heap = NULL;
+    pq->size = pq->cap = 0;
+}
+
+void pq_push(PQueue *pq, long long key, int id)
+{
+    if (pq->size == pq->cap) {
+        pq->cap *= 2;
+        pq->heap = (PQEntry *) realloc(pq->heap, pq->cap * sizeof(PQEntry));
+        if (!pq->heap) {
+            fprintf(stderr, "Fatal: realloc failed in pq_push\n");
+            exit(1);
+        }
+    }
+    pq->heap[pq->size].key = key;
+    pq->heap[pq->size].id = id;
+    pq_sift_up(pq, pq->size++);
+}
+
+PQEntry pq_pop(PQueue *pq)
+{
+    PQEntry top = pq->heap[0];
+    pq->heap[0] = pq->heap[--pq->size];
+    if (pq->size > 0)
+        pq_sift_down(pq, 0);
+    return top;
+}
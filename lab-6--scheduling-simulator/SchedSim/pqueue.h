@@ -0,0 +1,26 @@
+#ifndef PQUEUE_H
+#define PQUEUE_H
+
+/**
+ * Binary min-heap of process indices, ordered by key and then by index
+ * so that equal keys go to the process that comes first in plist.
+ */
+
+typedef struct PQEntry {
+    long long key;
+    int id;
+} PQEntry;
+
+typedef struct PQueue {
+    PQEntry *heap;
+    int size;
+    int cap;
+} PQueue;
+
+void pq_init(PQueue *pq, int cap);
+void pq_free(PQueue *pq);
+
+void pq_push(PQueue *pq, long long key, int id);
+PQEntry pq_pop(PQueue *pq);
+
+#endif				// PQUEUE_H
@@ -10,6 +10,28 @@ typedef struct Process {
     int pri; // priority
 }ProcessType; 
 
+// Counters of one simulated CPU
+typedef struct CpuStats {
+    long long busy; // time spent running processes
+    int completed; // processes that finished on this CPU
+    int stolen; // processes this CPU took from another run queue
+}CpuStatsType;
+
+// Results of one policy over a shared, read-only process table: wt[i] and
+// tat[i] belong to plist[i], and order lists the plist indices in the order
+// they are printed (NULL for plist order).
+typedef struct Result {
+    int *wt; // waiting time
+    int *tat; // turnaround time
+    int *rt; // response time: first run minus arrival
+    int *order;
+    long long switches; // times a CPU moved on to a different process
+    int ncpus;
+    CpuStatsType *cpu; // ncpus entries, allocated by simulate
+    long long makespan; // time the last process finished
+    struct Timeline *timeline; // run intervals are recorded here unless NULL
+}ResultType;
+
 typedef int (*Comparer) (const void *a, const void *b);
 
 #endif				// PROCESS_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Runs a command and reports its wall-clock time and peak resident set
+// size on stderr as "wall_s=SECONDS peak_rss_kb=KB", for the benchmark.
+// The command's own output and exit status pass through unchanged.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+int main(int argc, char *argv[])
+{
+    struct timespec t0, t1;
+    struct rusage ru;
+    int status;
+    pid_t pid;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: ./runstat <command> [args...]\n");
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "Fatal: fork failed\n");
+        exit(1);
+    }
+    if (pid == 0) {
+        execvp(argv[1], argv + 1);
+        fprintf(stderr, "Error: cannot run %s\n", argv[1]);
+        _exit(127);
+    }
+    if (wait4(pid, &status, 0, &ru) < 0) {
+        fprintf(stderr, "Fatal: wait4 failed\n");
+        exit(1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    fprintf(stderr, "wall_s=%.3f peak_rss_kb=%ld\n",
+            (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9, ru.ru_maxrss);
+    if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+    return WEXITSTATUS(status);
+}
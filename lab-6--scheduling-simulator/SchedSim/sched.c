@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "sched.h"
+#include "timeline.h"
+
+void *xmalloc(size_t size, const char *where)
+{
+    void *p = malloc(size > 0 ? size : 1);
+    if (!p) {
+        fprintf(stderr, "Fatal: malloc failed in %s\n", where);
+        exit(1);
+    }
+    return p;
+}
+
+// Sort key of a process: ascending major, then minor, then plist index
+typedef struct SortKey {
+    int major;
+    int minor;
+    int idx;
+} SortKey;
+
+static int sortkey_comparer(const void *this, const void *that)
+{
+    const SortKey *a = (const SortKey *)this;
+    const SortKey *b = (const SortKey *)that;
+
+    if (a->major != b->major)
+        return a->major < b->major ? -1 : 1;
+    if (a->minor != b->minor)
+        return a->minor < b->minor ? -1 : 1;
+    return a->idx - b->idx; // keep plist order among equal keys
+}
+
+// Sorts keys[0..n-1] and returns the plist indices in that order (caller frees)
+static int *sorted_order(SortKey *keys, int n)
+{
+    int *order = (int *) xmalloc(n * sizeof(int), "sorted_order");
+    qsort(keys, n, sizeof(SortKey), sortkey_comparer);
+    for (int i = 0; i < n; i++)
+        order[i] = keys[i].idx;
+    free(keys);
+    return order;
+}
+
+int *arrival_order(const ProcessType plist[], int n)
+{
+    SortKey *keys = (SortKey *) xmalloc(n * sizeof(SortKey), "arrival_order");
+    for (int i = 0; i < n; i++) {
+        keys[i].major = plist[i].art;
+        keys[i].minor = 0;
+        keys[i].idx = i;
+    }
+    return sorted_order(keys, n);
+}
+
+int *priority_order(const ProcessType plist[], int n)
+{
+    SortKey *keys = (SortKey *) xmalloc(n * sizeof(SortKey), "priority_order");
+    for (int i = 0; i < n; i++) {
+        keys[i].major = -plist[i].pri; // DESCENDING order
+        keys[i].minor = plist[i].art;
+        keys[i].idx = i;
+    }
+    return sorted_order(keys, n);
+}
+
+void derive_mlfq_quanta(SimParams *params, int given)
+{
+    for (int lvl = given; lvl < params->mlfq_levels; lvl++)
+        params->mlfq_quanta[lvl] = lvl == 0 ? params->quantum : 2 * params->mlfq_quanta[lvl - 1];
+}
+
+const Policy *policy_find(const char *name)
+{
+    for (int i = 0; policy_table[i]; i++) {
+        if (strcmp(policy_table[i]->name, name) == 0)
+            return policy_table[i];
+    }
+    return NULL;
+}
+
+// One simulated CPU: its policy context and the segment it is running
+typedef struct Core {
+    SimCtx ctx;
+    int running; // process on the CPU, -1 when idle
+    int last; // process that ran last, -1 before the first
+    long long start; // current segment runs from start to end
+    long long end;
+    int stopped; // the segment ended at the current time
+    int queued; // processes waiting in this CPU's run queue
+} Core;
+
+// Ends core's segment at time t and charges it to the running process
+static void stop_segment(Core *core, long long t, CpuStatsType *stats)
+{
+    long long ran = t > core->start ? t - core->start : 0;
+    core->ctx.rem[core->running] -= ran;
+    stats->busy += ran;
+    core->end = core->start + ran;
+    core->stopped = 1;
+}
+
+// New arrivals go to the CPU with the fewest processes, running included.
+// Ties go round robin, starting after the CPU picked last time, so an
+// idle machine spreads its work instead of piling it onto CPU 0.
+static int place(const Core cores[], int ncpus, int *last)
+{
+    int best = -1;
+    for (int k = 1; k <= ncpus; k++) {
+        int c = (*last + k) % ncpus;
+        if (best < 0 || cores[c].queued + (cores[c].running >= 0) <
+            cores[best].queued + (cores[best].running >= 0))
+            best = c;
+    }
+    *last = best;
+    return best;
+}
+
+// Has an idle CPU take a process from the longest other run queue
+static int steal_work(const Policy *pol, Core cores[], int ncpus, int thief, CpuStatsType *stats)
+{
+    int victim = -1;
+    for (int c = 0; c < ncpus; c++) {
+        if (c != thief && cores[c].queued > 0 &&
+            (victim < 0 || cores[c].queued > cores[victim].queued))
+            victim = c;
+    }
+    if (victim < 0)
+        return -1;
+    cores[victim].ctx.t = cores[thief].ctx.t;
+    if (pol->steal(&cores[thief].ctx, &cores[victim].ctx) < 0)
+        return -1;
+    cores[victim].queued--;
+    cores[thief].queued++;
+    stats[thief].stolen++;
+    return 0;
+}
+
+// Event loop over ncpus CPUs, each with its own run queue. At each event
+// time: end the segments that are due, place arrivals (preempting the
+// target CPU for preemptive policies), report the outcomes, then give
+// every idle CPU its next process, stealing when its own queue is empty.
+// Time jumps to the next segment end or arrival, so the cost is
+// O(n log n + number of segments * ncpus) plus the policy's own costs.
+void simulate(const Policy *pol, const ProcessType plist[], int n,
+              const SimParams *params, ResultType *res)
+{
+    int ncpus = params->cpus > 0 ? params->cpus : 1;
+    int *order = arrival_order(plist, n);
+    long long *rem = (long long *) xmalloc(n * sizeof(long long), "simulate");
+    Core *cores = (Core *) xmalloc(ncpus * sizeof(Core), "simulate");
+    CpuStatsType *stats = (CpuStatsType *) xmalloc(ncpus * sizeof(CpuStatsType), "simulate");
+    int next = 0; // next process to arrive, in arrival order
+    int done = 0;
+    int waiting = 0; // processes queued on any CPU
+    int placed = ncpus - 1; // CPU the last arrival went to
+    long long t = 0;
+
+    for (int i = 0; i < n; i++) {
+        rem[i] = plist[i].bt;
+        res->rt[i] = -1;
+    }
+    res->switches = 0;
+    for (int c = 0; c < ncpus; c++) {
+        SimCtx *ctx = &cores[c].ctx;
+        ctx->plist = plist;
+        ctx->n = n;
+        ctx->params = params;
+        ctx->t = 0;
+        ctx->rem = rem;
+        ctx->res = res;
+        ctx->state = NULL;
+        ctx->cpu = c;
+        ctx->ncpus = ncpus;
+        ctx->shared = c > 0 ? cores[0].ctx.shared : NULL;
+        pol->init(ctx);
+        cores[c].running = -1;
+        cores[c].last = -1;
+        cores[c].stopped = 0;
+        cores[c].queued = 0;
+        stats[c].busy = 0;
+        stats[c].completed = 0;
+        stats[c].stolen = 0;
+    }
+
+    while (done < n) {
+        // dispatch: every idle CPU picks from its own queue, then the ones
+        // still idle steal from the others
+        for (int pass = 0; pass < 2; pass++) {
+            for (int c = 0; c < ncpus; c++) {
+                Core *core = &cores[c];
+                long long slice = 0;
+                int i;
+
+                if (core->running >= 0)
+                    continue;
+                core->ctx.t = t;
+                if (pass == 1 && (waiting == 0 || !pol->steal ||
+                                  steal_work(pol, cores, ncpus, c, stats) < 0))
+                    continue;
+                i = pol->pick_next(&core->ctx, &slice);
+                if (i < 0)
+                    continue;
+                core->queued--;
+                waiting--;
+
+                // a pick that has not arrived yet leaves the CPU idle until then
+                core->start = plist[i].art > t ? plist[i].art : t;
+                core->end = core->start + rem[i];
+                if (slice > 0 && slice < rem[i])
+                    core->end = core->start + slice;
+                core->running = i;
+                if (res->rt[i] < 0)
+                    res->rt[i] = (int)(core->start - plist[i].art);
+                if (core->last >= 0 && core->last != i)
+                    res->switches++;
+                core->last = i;
+            }
+        }
+
+        // next event: a segment ends or a process arrives
+        long long now = LLONG_MAX;
+        for (int c = 0; c < ncpus; c++) {
+            if (cores[c].running >= 0 && cores[c].end < now)
+                now = cores[c].end;
+        }
+        if (next < n && plist[order[next]].art < now)
+            now = plist[order[next]].art;
+        if (now == LLONG_MAX) {
+            fprintf(stderr, "Fatal: policy %s has no process to run\n", pol->name);
+            exit(1);
+        }
+        t = now;
+
+        for (int c = 0; c < ncpus; c++) {
+            if (cores[c].running >= 0 && cores[c].end == t)
+                stop_segment(&cores[c], t, &stats[c]);
+        }
+
+        // arrivals are reported before the outcome of the segments that
+        // end at the same time
+        while (next < n && plist[order[next]].art <= t) {
+            int i = order[next++];
+            int c = place(cores, ncpus, &placed);
+            Core *core = &cores[c];
+
+            core->ctx.t = t;
+            if (pol->on_arrival)
+                pol->on_arrival(&core->ctx, i);
+            core->queued++;
+            waiting++;
+            if (pol->preempt_on_arrival && core->running >= 0 && !core->stopped)
+                stop_segment(core, t, &stats[c]);
+        }
+
+        for (int c = 0; c < ncpus; c++) {
+            Core *core = &cores[c];
+            int i = core->running;
+
+            if (!core->stopped)
+                continue;
+            if (res->timeline && core->end > core->start)
+                timeline_add(res->timeline, c, i, core->start, core->end);
+            core->stopped = 0;
+            core->running = -1;
+            core->ctx.t = t;
+            if (rem[i] == 0) {
+                res->wt[i] = (int)(t - plist[i].bt - plist[i].art);
+                stats[c].completed++;
+                done++;
+                if (pol->on_complete)
+                    pol->on_complete(&core->ctx, i);
+            } else {
+                pol->on_tick(&core->ctx, i, core->end - core->start);
+                core->queued++;
+                waiting++;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+        res->tat[i] = plist[i].bt + res->wt[i];
+    res->ncpus = ncpus;
+    res->cpu = stats;
+    res->makespan = t;
+    for (int c = ncpus - 1; c >= 0; c--) {
+        if (pol->fini)
+            pol->fini(&cores[c].ctx);
+    }
+    free(cores);
+    free(rem);
+    free(order);
+}
@@ -0,0 +1,109 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stddef.h>
+#include "process.h"
+
+/**
+ * Event-driven simulation engine and the scheduler policy interface.
+ *
+ * The engine owns time, arrivals and remaining burst times; a policy only
+ * decides what runs next. Time jumps from event to event (arrival, end of
+ * a slice, completion), never one unit at a time.
+ */
+
+#define MLFQ_MAX_LEVELS 16
+#define MAX_CPUS 256
+
+// Tunables shared by all policies
+typedef struct SimParams {
+    int quantum; // RR time slice
+    int cpus; // simulated CPUs, each with its own run queue
+    int mlfq_levels; // number of MLFQ queues
+    int mlfq_quanta[MLFQ_MAX_LEVELS]; // allotment per MLFQ level, top first
+    int mlfq_boost; // move everything to the top MLFQ queue this often (0: never)
+    int cfs_latency; // CFS period in which every runnable process runs once
+    int cfs_min_gran; // shortest CFS slice
+} SimParams;
+
+// State of one CPU's run queue in a simulation, passed to every policy
+// callback. Every CPU gets its own context and policy state; they share
+// the process table, rem and res.
+typedef struct SimCtx {
+    const ProcessType *plist; // read-only process table
+    int n;
+    const SimParams *params;
+    long long t; // current time
+    long long *rem; // remaining burst time per process
+    ResultType *res; // wt/tat scratch arrays and print order
+    void *state; // policy private data for this CPU, set by init
+    int cpu; // this CPU, 0 to ncpus-1
+    int ncpus;
+    // Per-process policy data shared by all CPUs (a process is queued on
+    // one CPU at a time). CPU 0's init sets it and the other CPUs get a
+    // copy; CPU 0's fini, which runs last, frees it.
+    void *shared;
+} SimCtx;
+
+typedef struct Policy {
+    const char *name; // used by --policy
+    const char *title_fmt; // section title, may use the quantum as %d
+
+    // Whether an arrival ends the running slice so pick_next can preempt
+    int preempt_on_arrival;
+
+    // Sets up ctx->state (and ctx->res->order to print in another order).
+    // Called once per CPU, CPU 0 first.
+    void (*init)(SimCtx *ctx);
+
+    // Returns the process to run next, or -1 if none is ready. *slice may
+    // be set to cap the run length (it starts at 0: run to completion).
+    // A process that has not arrived yet may be returned; the CPU then
+    // idles until it arrives.
+    int (*pick_next)(SimCtx *ctx, long long *slice);
+
+    // Process i arrived at ctx->t; may be NULL
+    void (*on_arrival)(SimCtx *ctx, int i);
+
+    // Process i ran for ran time units and is not done yet. Arrivals up
+    // to ctx->t have already been reported.
+    void (*on_tick)(SimCtx *ctx, int i, long long ran);
+
+    // Process i finished at ctx->t; may be NULL
+    void (*on_complete)(SimCtx *ctx, int i);
+
+    // Frees ctx->state; may be NULL
+    void (*fini)(SimCtx *ctx);
+
+    // Moves the process that from would run next to to's run queue and
+    // returns it, or -1 if from has none waiting. NULL if the policy only
+    // runs on one CPU.
+    int (*steal)(SimCtx *to, SimCtx *from);
+} Policy;
+
+// Gives MLFQ levels given..mlfq_levels-1 an allotment: the top level gets
+// the RR quantum and every other level twice the one above
+void derive_mlfq_quanta(SimParams *params, int given);
+
+// Registry of every known policy, NULL terminated (policies.c)
+extern const Policy *const policy_table[];
+
+// Returns the policy called name, or NULL
+const Policy *policy_find(const char *name);
+
+// Runs pol over plist on params->cpus CPUs and fills res->wt, res->tat,
+// res->rt, the context switch count and the per-CPU counters. If
+// res->timeline is set, every run interval is appended to it.
+void simulate(const Policy *pol, const ProcessType plist[], int n,
+              const SimParams *params, ResultType *res);
+
+// Returns the indices of plist ordered by arrival time (caller frees)
+int *arrival_order(const ProcessType plist[], int n);
+
+// Returns the indices of plist for Priority Scheduling: largest pri first,
+// ties broken by earlier arrival, then by plist order (caller frees)
+int *priority_order(const ProcessType plist[], int n);
+
+void *xmalloc(size_t size, const char *where);
+
+#endif				// SCHED_H
@@ -1,215 +1,362 @@
-// C program for implementation of Simulation 
+// C program for implementation of Simulation
 #include <stdio.h>
 #include <limits.h>
 #include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "process.h"
 #include "util.h"
+#include "sched.h"
+#include "trace.h"
+#include "metrics.h"
+#include "sweep.h"
+#include "timeline.h"
 
-// Function to find the waiting time for Round Robin
-void findWaitingTimeRR(ProcessType plist[], int n, int quantum) 
-{ 
-    int rem_bt[n];
-    for (int i = 0; i < n; i++)
-        rem_bt[i] = plist[i].bt;
-    
-    int t = 0; // Current time
-    int done;
-    do {
-        done = 1;
-        for (int i = 0; i < n; i++) {
-            if (rem_bt[i] > 0 && plist[i].art <= t) {
-                done = 0;
-                if (rem_bt[i] > quantum) {
-                    t += quantum;
-                    rem_bt[i] -= quantum;
-                } else {
-                    t += rem_bt[i];
-                    plist[i].wt = t - plist[i].bt - plist[i].art;
-                    rem_bt[i] = 0;
-                }
-            }
+ProcessType * initProc(char *filename, int *n)
+{
+    ProcessType *plist = parse_file(filename, n);
+    if (!plist) {
+        fprintf(stderr, "Error: Invalid filepath\n");
+        fflush(stdout);
+        exit(0);
+    }
+    return plist;
+}
+
+// Parses the trace at path, or maps a binary one and uses it in place
+static void load_input(char *path, int binary, TraceInput *in, Trace *trace)
+{
+    in->path = path;
+    if (binary) {
+        if (trace_map(path, trace) < 0) {
+            fprintf(stderr, "Error: Invalid filepath\n");
+            exit(0);
         }
-        // If no process was ready, advance time
-        if (done) {
-            for (int i = 0; i < n; i++) {
-                if (rem_bt[i] > 0) {
-                    t++;
-                    done = 0;
-                    break;
-                }
-            }
+        in->plist = trace->plist;
+        in->n = trace->n;
+    } else {
+        in->plist = initProc(path, &in->n);
+    }
+}
+
+static void free_input(TraceInput *in, int binary, Trace *trace)
+{
+    if (binary)
+        trace_unmap(trace);
+    else
+        free((void *)in->plist);
+}
+
+// One policy, run on its own thread over the shared process table. Each
+// run only writes its own scratch result arrays, and reduces them to its
+// summary metrics on the same thread.
+typedef struct PolicyRun {
+    const Policy *policy;
+    const ProcessType *plist;
+    int n;
+    const SimParams *params;
+    ResultType res;
+    MetricsType metrics;
+    pthread_t thread;
+} PolicyRun;
+
+static void *policy_thread(void *arg)
+{
+    PolicyRun *r = (PolicyRun *)arg;
+    simulate(r->policy, r->plist, r->n, r->params, &r->res);
+    compute_metrics(r->plist, &r->res, r->n, &r->metrics);
+    return NULL;
+}
+
+// Policies run when --policy is not given
+#define DEFAULT_POLICIES "fcfs,sjf,priority,rr"
+
+// Resolves a comma separated list of policy names into runs[]; returns how
+// many, or exits on an unknown name. With several CPUs, policies that only
+// run on one are an error when named and skipped from the default list.
+static int select_policies(char *list, int named, int cpus, PolicyRun *runs, int max)
+{
+    int count = 0;
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        const Policy *pol = policy_find(name);
+        if (!pol) {
+            fprintf(stderr, "Error: unknown policy '%s'; available:", name);
+            for (int i = 0; policy_table[i]; i++)
+                fprintf(stderr, " %s", policy_table[i]->name);
+            fprintf(stderr, "\n");
+            exit(1);
         }
-    } while (!done);
-} 
-
-// Function to find waiting time for SRTF (preemptive SJF)
-void findWaitingTimeSJF(ProcessType plist[], int n)
-{ 
-    int rem_bt[n];
-    int complete = 0, t = 0, min_index = -1;
-    int min_bt;
-    
-    for (int i = 0; i < n; i++)
-        rem_bt[i] = plist[i].bt;
-    
-    while (complete < n) {
-        min_bt = INT_MAX;
-        min_index = -1;
-        for (int i = 0; i < n; i++) {
-            if (plist[i].art <= t && rem_bt[i] > 0 && rem_bt[i] < min_bt) {
-                min_bt = rem_bt[i];
-                min_index = i;
-            }
+        if (cpus > 1 && !pol->steal) {
+            if (!named)
+                continue;
+            fprintf(stderr, "Error: policy '%s' only runs on one CPU\n", name);
+            exit(1);
         }
-        if (min_index == -1) { // No process has arrived yet
-            t++;
-            continue;
+        if (count == max) {
+            fprintf(stderr, "Error: too many policies\n");
+            exit(1);
         }
-        rem_bt[min_index]--;
-        t++;
-        if (rem_bt[min_index] == 0) {
-            plist[min_index].wt = t - plist[min_index].bt - plist[min_index].art;
-            complete++;
+        runs[count++].policy = pol;
+    }
+    return count;
+}
+
+// Runs each policy on its own thread and reports them in the order they
+// were listed once each has finished. With a timeline file, every run also
+// records its intervals and they are exported there.
+static void run_policies(PolicyRun runs[], int nruns, const ProcessType proc_list[], int n,
+                         const SimParams *params, OutputFormat format, FILE *timeline)
+{
+    for (int r = 0; r < nruns; r++) {
+        runs[r].plist = proc_list;
+        runs[r].n = n;
+        runs[r].params = params;
+        runs[r].res.wt = (int *) xmalloc(n * sizeof(int), "run_policies");
+        runs[r].res.tat = (int *) xmalloc(n * sizeof(int), "run_policies");
+        runs[r].res.rt = (int *) xmalloc(n * sizeof(int), "run_policies");
+        runs[r].res.order = NULL;
+        runs[r].res.cpu = NULL;
+        runs[r].res.timeline = timeline ? timeline_new(params->cpus) : NULL;
+        if (pthread_create(&runs[r].thread, NULL, policy_thread, &runs[r]) != 0) {
+            fprintf(stderr, "Fatal: pthread_create failed in run_policies\n");
+            exit(1);
         }
     }
-} 
-
-// Function to find waiting time for FCFS considering arrival times
-void findWaitingTime(ProcessType plist[], int n)
-{ 
-    int t = 0; // current time
-    for (int i = 0; i < n; i++) {
-        if (t < plist[i].art)
-            t = plist[i].art; // wait for process to arrive
-        plist[i].wt = t - plist[i].art;
-        t += plist[i].bt;
+
+    print_report_begin(format);
+    if (timeline)
+        timeline_write_begin(timeline);
+    for (int r = 0; r < nruns; r++) {
+        char title[64];
+        pthread_join(runs[r].thread, NULL);
+        snprintf(title, sizeof(title), runs[r].policy->title_fmt, params->quantum);
+        print_report(format, runs[r].policy->name, title, proc_list, &runs[r].res, n, &runs[r].metrics, r == 0);
+        if (timeline)
+            timeline_write_run(timeline, runs[r].res.timeline, r, runs[r].policy->name,
+                               title, proc_list, r == 0);
+        timeline_free(runs[r].res.timeline);
+        free(runs[r].res.wt);
+        free(runs[r].res.tat);
+        free(runs[r].res.rt);
+        free(runs[r].res.order);
+        free(runs[r].res.cpu);
     }
-} 
-  
-// Function to calculate turn around time 
-void findTurnAroundTime(ProcessType plist[], int n)
-{ 
-    for (int i = 0; i < n; i++)
-        plist[i].tat = plist[i].bt + plist[i].wt;
-} 
-  
-// Comparator for Priority Scheduling (Descending order: largest pri first)
-int my_comparer(const void *this, const void *that)
-{ 
-    ProcessType *a = (ProcessType *)this;
-    ProcessType *b = (ProcessType *)that;
-
-    if (a->pri != b->pri)
-        return b->pri - a->pri; // DESCENDING order
-    return a->art - b->art; // tie-breaker: earlier arrival
-} 
-
-// Calculate average time FCFS
-void findavgTimeFCFS(ProcessType plist[], int n) 
-{ 
-    findWaitingTime(plist, n); 
-    findTurnAroundTime(plist, n); 
-    printf("\n*********\nFCFS\n");
+    print_report_end(format);
+    if (timeline)
+        timeline_write_end(timeline);
 }
 
-// Calculate average time SJF
-void findavgTimeSJF(ProcessType plist[], int n) 
-{ 
-    findWaitingTimeSJF(plist, n); 
-    findTurnAroundTime(plist, n); 
-    printf("\n*********\nSJF (Preemptive/SRTF)\n");
+// Returns optarg as an int, or exits if it is below min
+static int int_arg(const char *what, const char *arg, int min)
+{
+    int v = atoi(arg);
+    if (v < min) {
+        fprintf(stderr, "Error: %s must be at least %d\n", what, min);
+        exit(1);
+    }
+    return v;
 }
 
-// Calculate average time RR
-void findavgTimeRR(ProcessType plist[], int n, int quantum) 
-{ 
-    findWaitingTimeRR(plist, n, quantum); 
-    findTurnAroundTime(plist, n); 
-    printf("\n*********\nRR Quantum = %d\n", quantum);
+// Parses a comma separated list of MLFQ allotments, top level first;
+// returns how many
+static int parse_quanta(char *list, int quanta[], int max)
+{
+    int count = 0;
+    for (char *q = strtok(list, ","); q; q = strtok(NULL, ",")) {
+        if (count == max) {
+            fprintf(stderr, "Error: at most %d MLFQ levels\n", max);
+            exit(1);
+        }
+        quanta[count++] = int_arg("an MLFQ quantum", q, 1);
+    }
+    return count;
 }
 
-// Calculate average time Priority
-void findavgTimePriority(ProcessType plist[], int n) 
-{ 
-    qsort(plist, n, sizeof(ProcessType), my_comparer);
-    findWaitingTime(plist, n); // now considers arrival times
-    findTurnAroundTime(plist, n); 
-    printf("\n*********\nPriority\n");
+static void usage(void)
+{
+    fprintf(stderr, "Usage: ./schedsim [--quantum=N] [--policy=a,b,c] [--cpus=N] [--binary]\n"
+            "                  [--format=text|csv|json] [--timeline=file.json]\n"
+            "                  [--mlfq-levels=N] [--mlfq-quanta=a,b,c] [--mlfq-boost=N]\n"
+            "                  [--cfs-latency=N] [--cfs-min-gran=N] <input-file-path>\n"
+            "       ./schedsim --sweep=name=LO..HI[:STEP][,...] [--sweep=...] [--jobs=N]\n"
+            "                  [--quantum=N] [--policy=a,b,c] [--cpus=N] [--binary]\n"
+            "                  [--format=text|csv|json]\n"
+            "                  [--mlfq-levels=N] [--mlfq-quanta=a,b,c] [--mlfq-boost=N]\n"
+            "                  [--cfs-latency=N] [--cfs-min-gran=N] <input-file-path>...\n");
+    fflush(stdout);
 }
 
-// Print metrics
-void printMetrics(ProcessType plist[], int n)
-{
-    int total_wt = 0, total_tat = 0; 
-    float awt, att;
-    
-    printf("\tProcesses\tBurst time\tWaiting time\tTurn around time\n"); 
-    for (int i = 0; i < n; i++) {
-        total_wt += plist[i].wt; 
-        total_tat += plist[i].tat; 
-        printf("\t%d\t\t%d\t\t%d\t\t%d\n", plist[i].pid, plist[i].bt, plist[i].wt, plist[i].tat); 
-    } 
-  
-    awt = ((float)total_wt / (float)n);
-    att = ((float)total_tat / (float)n);
-    
-    printf("\nAverage waiting time = %.2f", awt); 
-    printf("\nAverage turn around time = %.2f\n", att); 
-} 
-
-ProcessType * initProc(char *filename, int *n) 
+// Long-only options
+enum {
+    OPT_MLFQ_LEVELS = 256,
+    OPT_MLFQ_QUANTA,
+    OPT_MLFQ_BOOST,
+    OPT_CFS_LATENCY,
+    OPT_CFS_MIN_GRAN,
+    OPT_CPUS,
+    OPT_FORMAT,
+    OPT_SWEEP,
+    OPT_JOBS,
+    OPT_TIMELINE
+};
+
+// Driver code
+int main(int argc, char *argv[])
 {
-    FILE *input_file = fopen(filename, "r");
-    if (!input_file) {
-        fprintf(stderr, "Error: Invalid filepath\n");
-        fflush(stdout);
-        exit(0);
+    SweepDim dims[SWEEP_MAX_DIMS];
+    int ndims = 0;
+    int nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    SimParams params = { 2 };
+    int nquanta = 0;
+    char policies[256] = DEFAULT_POLICIES;
+    int named = 0;
+    OutputFormat format = FORMAT_TEXT;
+    PolicyRun runs[64];
+    int binary = 0;
+    const char *timeline_path = NULL;
+    FILE *timeline = NULL;
+    static struct option long_options[] = {
+        {"quantum", required_argument, NULL, 'q'},
+        {"binary", no_argument, NULL, 'b'},
+        {"policy", required_argument, NULL, 'p'},
+        {"mlfq-levels", required_argument, NULL, OPT_MLFQ_LEVELS},
+        {"mlfq-quanta", required_argument, NULL, OPT_MLFQ_QUANTA},
+        {"mlfq-boost", required_argument, NULL, OPT_MLFQ_BOOST},
+        {"cfs-latency", required_argument, NULL, OPT_CFS_LATENCY},
+        {"cfs-min-gran", required_argument, NULL, OPT_CFS_MIN_GRAN},
+        {"cpus", required_argument, NULL, OPT_CPUS},
+        {"format", required_argument, NULL, OPT_FORMAT},
+        {"sweep", required_argument, NULL, OPT_SWEEP},
+        {"jobs", required_argument, NULL, OPT_JOBS},
+        {"timeline", required_argument, NULL, OPT_TIMELINE},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+
+    params.cpus = 1;
+    params.mlfq_levels = 0; // from --mlfq-quanta, else 3
+    params.mlfq_boost = 100;
+    params.cfs_latency = 12;
+    params.cfs_min_gran = 1;
+
+    while ((opt = getopt_long(argc, argv, "q:bp:", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'q':
+            params.quantum = int_arg("quantum", optarg, 1);
+            break;
+        case 'b':
+            binary = 1;
+            break;
+        case 'p':
+            snprintf(policies, sizeof(policies), "%s", optarg);
+            named = 1;
+            break;
+        case OPT_MLFQ_LEVELS:
+            params.mlfq_levels = int_arg("mlfq-levels", optarg, 1);
+            if (params.mlfq_levels > MLFQ_MAX_LEVELS) {
+                fprintf(stderr, "Error: at most %d MLFQ levels\n", MLFQ_MAX_LEVELS);
+                return 1;
+            }
+            break;
+        case OPT_MLFQ_QUANTA:
+            nquanta = parse_quanta(optarg, params.mlfq_quanta, MLFQ_MAX_LEVELS);
+            break;
+        case OPT_MLFQ_BOOST:
+            params.mlfq_boost = int_arg("mlfq-boost", optarg, 0);
+            break;
+        case OPT_CFS_LATENCY:
+            params.cfs_latency = int_arg("cfs-latency", optarg, 1);
+            break;
+        case OPT_CFS_MIN_GRAN:
+            params.cfs_min_gran = int_arg("cfs-min-gran", optarg, 1);
+            break;
+        case OPT_CPUS:
+            params.cpus = int_arg("cpus", optarg, 1);
+            if (params.cpus > MAX_CPUS) {
+                fprintf(stderr, "Error: at most %d CPUs\n", MAX_CPUS);
+                return 1;
+            }
+            break;
+        case OPT_FORMAT:
+            if (strcmp(optarg, "text") == 0)
+                format = FORMAT_TEXT;
+            else if (strcmp(optarg, "csv") == 0)
+                format = FORMAT_CSV;
+            else if (strcmp(optarg, "json") == 0)
+                format = FORMAT_JSON;
+            else {
+                fprintf(stderr, "Error: unknown format '%s'; use text, csv or json\n", optarg);
+                return 1;
+            }
+            break;
+        case OPT_SWEEP:
+            if (ndims == SWEEP_MAX_DIMS) {
+                fprintf(stderr, "Error: at most %d swept parameters\n", SWEEP_MAX_DIMS);
+                return 1;
+            }
+            sweep_parse(optarg, &dims[ndims++]);
+            break;
+        case OPT_JOBS:
+            nthreads = int_arg("jobs", optarg, 1);
+            break;
+        case OPT_TIMELINE:
+            timeline_path = optarg;
+            break;
+        default:
+            usage();
+            return 1;
+        }
     }
-    ProcessType *plist = parse_file(input_file, n);
-    fclose(input_file);
-    return plist;
-}
-  
-// Driver code 
-int main(int argc, char *argv[]) 
-{ 
-    int n; 
-    int quantum = 2;
-    ProcessType *proc_list;
-  
-    if (argc < 2) {
-        fprintf(stderr, "Usage: ./schedsim <input-file-path>\n");
-        fflush(stdout);
+    // A single run takes exactly one trace, a sweep one or more
+    if (optind >= argc || (ndims == 0 && argc - optind > 1)) {
+        usage();
+        return 1;
+    }
+    if (timeline_path && ndims > 0) {
+        fprintf(stderr, "Error: --timeline cannot be combined with --sweep\n");
         return 1;
     }
-    
-    // FCFS
-    n = 0;
-    proc_list = initProc(argv[1], &n);
-    findavgTimeFCFS(proc_list, n);
-    printMetrics(proc_list, n);
-    free(proc_list);
-  
-    // SJF
-    n = 0;
-    proc_list = initProc(argv[1], &n);
-    findavgTimeSJF(proc_list, n); 
-    printMetrics(proc_list, n);
-    free(proc_list);
-  
-    // Priority
-    n = 0; 
-    proc_list = initProc(argv[1], &n);
-    findavgTimePriority(proc_list, n); 
-    printMetrics(proc_list, n);
-    free(proc_list);
-    
-    // RR
-    n = 0;
-    proc_list = initProc(argv[1], &n);
-    findavgTimeRR(proc_list, n, quantum); 
-    printMetrics(proc_list, n);
-    free(proc_list);
-    
-    return 0; 
-} 
+    if (timeline_path && !(timeline = fopen(timeline_path, "w"))) {
+        fprintf(stderr, "Error: cannot create %s\n", timeline_path);
+        return 1;
+    }
+
+    if (params.mlfq_levels == 0)
+        params.mlfq_levels = nquanta > 0 ? nquanta : 3;
+    derive_mlfq_quanta(&params, nquanta);
+
+    // Parse once; every policy reads the same table. A binary trace is
+    // used in place from its mapping. A sweep takes several traces.
+    int ninputs = argc - optind;
+    TraceInput *inputs = (TraceInput *) xmalloc(ninputs * sizeof(TraceInput), "main");
+    Trace *traces = (Trace *) xmalloc(ninputs * sizeof(Trace), "main");
+    for (int k = 0; k < ninputs; k++)
+        load_input(argv[optind + k], binary, &inputs[k], &traces[k]);
+
+    int cpus = ndims > 0 ? sweep_max(dims, ndims, "cpus", params.cpus) : params.cpus;
+    int nruns = select_policies(policies, named, cpus, runs, sizeof(runs) / sizeof(runs[0]));
+
+    if (ndims > 0) {
+        const Policy *sweep_policies[64];
+        for (int r = 0; r < nruns; r++)
+            sweep_policies[r] = runs[r].policy;
+        run_sweep(dims, ndims, sweep_policies, nruns, inputs, ninputs,
+                  &params, nquanta, nthreads, format);
+        for (int d = 0; d < ndims; d++)
+            sweep_free(&dims[d]);
+    } else {
+        run_policies(runs, nruns, inputs[0].plist, inputs[0].n, &params, format, timeline);
+    }
+    if (timeline && fclose(timeline) != 0) {
+        fprintf(stderr, "Error: writing %s failed\n", timeline_path);
+        return 1;
+    }
+
+    for (int k = 0; k < ninputs; k++)
+        free_input(&inputs[k], binary, &traces[k]);
+    free(inputs);
+    free(traces);
+    return 0;
+}
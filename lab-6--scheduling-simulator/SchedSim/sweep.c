@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "sweep.h"
+
+// The SimParams fields --sweep can vary
+typedef struct Sweepable {
+    const char *name;
+    size_t offset;
+    int min;
+    int max;
+} Sweepable;
+
+static const Sweepable sweepable[] = {
+    {"quantum", offsetof(SimParams, quantum), 1, INT_MAX},
+    {"cpus", offsetof(SimParams, cpus), 1, MAX_CPUS},
+    {"mlfq-levels", offsetof(SimParams, mlfq_levels), 1, MLFQ_MAX_LEVELS},
+    {"mlfq-boost", offsetof(SimParams, mlfq_boost), 0, INT_MAX},
+    {"cfs-latency", offsetof(SimParams, cfs_latency), 1, INT_MAX},
+    {"cfs-min-gran", offsetof(SimParams, cfs_min_gran), 1, INT_MAX},
+    {NULL, 0, 0, 0}
+};
+
+static void sweep_add(SweepDim *dim, long v, int min, int max)
+{
+    if (v < min || v > max) {
+        fprintf(stderr, "Error: %s must be between %d and %d\n", dim->name, min, max);
+        exit(1);
+    }
+    if (dim->count == SWEEP_MAX_VALUES) {
+        fprintf(stderr, "Error: at most %d values per swept parameter\n", SWEEP_MAX_VALUES);
+        exit(1);
+    }
+    dim->values[dim->count++] = (int)v;
+}
+
+void sweep_parse(char *spec, SweepDim *dim)
+{
+    char *eq = strchr(spec, '=');
+    const Sweepable *sw;
+
+    if (eq)
+        *eq = '\0';
+    for (sw = sweepable; sw->name && strcmp(sw->name, spec) != 0; sw++)
+        ;
+    if (!eq || !sw->name) {
+        fprintf(stderr, "Error: bad sweep '%s'; use name=LO..HI[:STEP] with name one of:", spec);
+        for (sw = sweepable; sw->name; sw++)
+            fprintf(stderr, " %s", sw->name);
+        fprintf(stderr, "\n");
+        exit(1);
+    }
+
+    dim->name = sw->name;
+    dim->offset = sw->offset;
+    dim->values = (int *) xmalloc(SWEEP_MAX_VALUES * sizeof(int), "sweep_parse");
+    dim->count = 0;
+    for (char *item = strtok(eq + 1, ","); item; item = strtok(NULL, ",")) {
+        char *end;
+        long lo = strtol(item, &end, 10), hi = lo, step = 1;
+
+        if (end != item && strncmp(end, "..", 2) == 0) {
+            char *from = end + 2;
+            hi = strtol(from, &end, 10);
+            if (end == from)
+                end = item; // no upper bound: reject below
+            else if (*end == ':')
+                step = strtol(end + 1, &end, 10);
+        }
+        if (end == item || *end != '\0' || step < 1 || hi < lo) {
+            fprintf(stderr, "Error: bad sweep value '%s' for %s\n", item, dim->name);
+            exit(1);
+        }
+        for (long v = lo; v <= hi; v += step)
+            sweep_add(dim, v, sw->min, sw->max);
+    }
+    if (dim->count == 0) {
+        fprintf(stderr, "Error: no values to sweep for %s\n", dim->name);
+        exit(1);
+    }
+}
+
+int sweep_max(const SweepDim dims[], int ndims, const char *name, int dflt)
+{
+    for (int d = 0; d < ndims; d++) {
+        if (strcmp(dims[d].name, name) == 0) {
+            int max = dims[d].values[0];
+            for (int k = 1; k < dims[d].count; k++)
+                if (dims[d].values[k] > max)
+                    max = dims[d].values[k];
+            return max;
+        }
+    }
+    return dflt;
+}
+
+void sweep_free(SweepDim *dim)
+{
+    free(dim->values);
+    dim->values = NULL;
+    dim->count = 0;
+}
+
+// Summary of one job
+typedef struct SweepResult {
+    MetricsType m;
+    long long switches;
+    long long makespan;
+    int migrations;
+} SweepResult;
+
+// Work shared by the workers. Job j is input j / (npolicies * grid),
+// policy j / grid % npolicies, and parameter combination j % grid with
+// the first swept parameter varying slowest.
+typedef struct SweepPool {
+    const SweepDim *dims;
+    int ndims;
+    const Policy *const *policies;
+    int npolicies;
+    const TraceInput *inputs;
+    const SimParams *base;
+    int nquanta;
+    int grid; // parameter combinations
+    int njobs;
+    int max_n; // largest trace, sizes the scratch arrays
+    pthread_mutex_t lock;
+    int next; // next job to hand out
+    SweepResult *results;
+} SweepPool;
+
+// Parameters of job j; values[] gets the swept values, one per dim
+static void job_params(const SweepPool *pool, int j, SimParams *p, int values[])
+{
+    int combo = j % pool->grid;
+
+    *p = *pool->base;
+    for (int d = pool->ndims - 1; d >= 0; d--) {
+        const SweepDim *dim = &pool->dims[d];
+        values[d] = dim->values[combo % dim->count];
+        combo /= dim->count;
+        *(int *)((char *)p + dim->offset) = values[d];
+    }
+    derive_mlfq_quanta(p, pool->nquanta);
+}
+
+static void *sweep_worker(void *arg)
+{
+    SweepPool *pool = (SweepPool *)arg;
+    ResultType res;
+    int values[SWEEP_MAX_DIMS];
+
+    // private scratch, reused by every job this worker runs
+    res.wt = (int *) xmalloc(pool->max_n * sizeof(int), "sweep_worker");
+    res.tat = (int *) xmalloc(pool->max_n * sizeof(int), "sweep_worker");
+    res.rt = (int *) xmalloc(pool->max_n * sizeof(int), "sweep_worker");
+
+    for (;;) {
+        int j;
+        pthread_mutex_lock(&pool->lock);
+        j = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (j >= pool->njobs)
+            break;
+
+        const TraceInput *in = &pool->inputs[j / (pool->npolicies * pool->grid)];
+        const Policy *pol = pool->policies[j / pool->grid % pool->npolicies];
+        SweepResult *r = &pool->results[j];
+        SimParams p;
+
+        job_params(pool, j, &p, values);
+        res.order = NULL;
+        res.cpu = NULL;
+        res.timeline = NULL;
+        simulate(pol, in->plist, in->n, &p, &res);
+        compute_metrics(in->plist, &res, in->n, &r->m);
+        r->switches = res.switches;
+        r->makespan = res.makespan;
+        r->migrations = 0;
+        for (int c = 0; c < res.ncpus; c++)
+            r->migrations += res.cpu[c].stolen;
+        free(res.order);
+        free(res.cpu);
+    }
+
+    free(res.wt);
+    free(res.tat);
+    free(res.rt);
+    return NULL;
+}
+
+// Prints s as a JSON string
+static void print_json_string(const char *s)
+{
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            putchar('\\');
+        putchar(*s);
+    }
+    putchar('"');
+}
+
+static void print_header(const SweepPool *pool, OutputFormat format)
+{
+    if (format == FORMAT_TEXT) {
+        printf("\tTrace\tPolicy");
+        for (int d = 0; d < pool->ndims; d++)
+            printf("\t%s", pool->dims[d].name);
+        printf("\tAvg wt\tp99 wt\tAvg tat\tp99 tat\tAvg rt\tp99 rt"
+               "\tThroughput\tUtilization\tSwitches\tMigrations\tFairness\n");
+    } else if (format == FORMAT_CSV) {
+        printf("trace,policy");
+        for (int d = 0; d < pool->ndims; d++)
+            printf(",%s", pool->dims[d].name);
+        printf(",makespan,avg_wt,p50_wt,p90_wt,p99_wt,max_wt,"
+               "avg_tat,p50_tat,p90_tat,p99_tat,max_tat,"
+               "avg_rt,p50_rt,p90_rt,p99_rt,max_rt,"
+               "throughput,utilization,context_switches,migrations,fairness\n");
+    } else {
+        printf("[");
+    }
+}
+
+static void print_row(const SweepPool *pool, int j, OutputFormat format)
+{
+    const TraceInput *in = &pool->inputs[j / (pool->npolicies * pool->grid)];
+    const Policy *pol = pool->policies[j / pool->grid % pool->npolicies];
+    const SweepResult *r = &pool->results[j];
+    const MetricsType *m = &r->m;
+    int values[SWEEP_MAX_DIMS];
+    SimParams p;
+
+    job_params(pool, j, &p, values);
+    switch (format) {
+    case FORMAT_TEXT:
+        printf("\t%s\t%s", in->path, pol->name);
+        for (int d = 0; d < pool->ndims; d++)
+            printf("\t%d", values[d]);
+        printf("\t%.2f\t%d\t%.2f\t%d\t%.2f\t%d\t%.4f\t%.2f%%\t%lld\t%d\t%.4f\n",
+               m->wt.avg, m->wt.p99, m->tat.avg, m->tat.p99, m->rt.avg, m->rt.p99,
+               m->throughput, 100.0 * m->utilization, r->switches, r->migrations, m->fairness);
+        break;
+    case FORMAT_CSV:
+        printf("\"%s\",%s", in->path, pol->name);
+        for (int d = 0; d < pool->ndims; d++)
+            printf(",%d", values[d]);
+        printf(",%lld", r->makespan);
+        printf(",%.2f,%d,%d,%d,%d", m->wt.avg, m->wt.p50, m->wt.p90, m->wt.p99, m->wt.max);
+        printf(",%.2f,%d,%d,%d,%d", m->tat.avg, m->tat.p50, m->tat.p90, m->tat.p99, m->tat.max);
+        printf(",%.2f,%d,%d,%d,%d", m->rt.avg, m->rt.p50, m->rt.p90, m->rt.p99, m->rt.max);
+        printf(",%.6f,%.6f,%lld,%d,%.6f\n", m->throughput, m->utilization,
+               r->switches, r->migrations, m->fairness);
+        break;
+    case FORMAT_JSON:
+        printf("%s\n  {\"trace\": ", j ? "," : "");
+        print_json_string(in->path);
+        printf(", \"policy\": \"%s\", \"params\": {", pol->name);
+        for (int d = 0; d < pool->ndims; d++)
+            printf("%s\"%s\": %d", d ? ", " : "", pool->dims[d].name, values[d]);
+        printf("}, \"makespan\": %lld", r->makespan);
+        printf(", \"wt\": {\"avg\": %.2f, \"p50\": %d, \"p90\": %d, \"p99\": %d, \"max\": %d}",
+               m->wt.avg, m->wt.p50, m->wt.p90, m->wt.p99, m->wt.max);
+        printf(", \"tat\": {\"avg\": %.2f, \"p50\": %d, \"p90\": %d, \"p99\": %d, \"max\": %d}",
+               m->tat.avg, m->tat.p50, m->tat.p90, m->tat.p99, m->tat.max);
+        printf(", \"rt\": {\"avg\": %.2f, \"p50\": %d, \"p90\": %d, \"p99\": %d, \"max\": %d}",
+               m->rt.avg, m->rt.p50, m->rt.p90, m->rt.p99, m->rt.max);
+        printf(", \"throughput\": %.6f, \"utilization\": %.6f, \"context_switches\": %lld"
+               ", \"migrations\": %d, \"fairness\": %.6f}",
+               m->throughput, m->utilization, r->switches, r->migrations, m->fairness);
+        break;
+    }
+}
+
+void run_sweep(const SweepDim dims[], int ndims,
+               const Policy *const policies[], int npolicies,
+               const TraceInput inputs[], int ninputs,
+               const SimParams *base, int nquanta, int nthreads, OutputFormat format)
+{
+    SweepPool pool;
+    pthread_t *threads;
+    struct timespec start, end;
+
+    pool.dims = dims;
+    pool.ndims = ndims;
+    pool.policies = policies;
+    pool.npolicies = npolicies;
+    pool.inputs = inputs;
+    pool.base = base;
+    pool.nquanta = nquanta;
+    pool.grid = 1;
+    for (int d = 0; d < ndims; d++)
+        pool.grid *= dims[d].count;
+    if ((long long)pool.grid * npolicies * ninputs > INT_MAX) {
+        fprintf(stderr, "Error: sweep has too many jobs\n");
+        exit(1);
+    }
+    pool.njobs = pool.grid * npolicies * ninputs;
+    pool.max_n = 0;
+    for (int k = 0; k < ninputs; k++)
+        if (inputs[k].n > pool.max_n)
+            pool.max_n = inputs[k].n;
+    pool.next = 0;
+    pool.results = (SweepResult *) xmalloc(pool.njobs * sizeof(SweepResult), "run_sweep");
+    pthread_mutex_init(&pool.lock, NULL);
+
+    if (nthreads > pool.njobs)
+        nthreads = pool.njobs;
+    threads = (pthread_t *) xmalloc(nthreads * sizeof(pthread_t), "run_sweep");
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int w = 0; w < nthreads; w++) {
+        if (pthread_create(&threads[w], NULL, sweep_worker, &pool) != 0) {
+            fprintf(stderr, "Fatal: pthread_create failed in run_sweep\n");
+            exit(1);
+        }
+    }
+    for (int w = 0; w < nthreads; w++)
+        pthread_join(threads[w], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    fprintf(stderr, "sweep: %d jobs on %d threads in %.3f s\n", pool.njobs, nthreads,
+            (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+    // rows in job order, whichever worker ran them
+    print_header(&pool, format);
+    for (int j = 0; j < pool.njobs; j++)
+        print_row(&pool, j, format);
+    if (format == FORMAT_JSON)
+        printf("\n]\n");
+
+    pthread_mutex_destroy(&pool.lock);
+    free(threads);
+    free(pool.results);
+}
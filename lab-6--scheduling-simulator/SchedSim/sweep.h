@@ -0,0 +1,52 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stddef.h>
+#include "process.h"
+#include "sched.h"
+#include "metrics.h"
+
+/**
+ * Parameter sweeps: every combination of traces x policies x swept
+ * parameter values is one job. The traces are loaded once and shared
+ * read-only; a pool of worker threads runs the jobs, each worker reusing
+ * its own scratch result arrays, and the summaries come out as one table.
+ */
+
+#define SWEEP_MAX_DIMS 4
+#define SWEEP_MAX_VALUES 4096
+
+// One swept SimParams field and the values it takes
+typedef struct SweepDim {
+    const char *name;
+    size_t offset; // of the int field in SimParams
+    int *values;
+    int count;
+} SweepDim;
+
+// A loaded trace
+typedef struct TraceInput {
+    const char *path;
+    const ProcessType *plist;
+    int n;
+} TraceInput;
+
+// Parses "name=values" where values is a comma separated list of N and
+// LO..HI[:STEP] items; exits on a bad spec
+void sweep_parse(char *spec, SweepDim *dim);
+
+// Largest value swept for the parameter called name, or dflt if it is
+// not swept
+int sweep_max(const SweepDim dims[], int ndims, const char *name, int dflt);
+
+// Runs every job on nthreads workers and prints the table. nquanta is the
+// number of MLFQ allotments given on the command line; the rest are
+// derived per job, so they follow a swept quantum.
+void run_sweep(const SweepDim dims[], int ndims,
+               const Policy *const policies[], int npolicies,
+               const TraceInput inputs[], int ninputs,
+               const SimParams *base, int nquanta, int nthreads, OutputFormat format);
+
+void sweep_free(SweepDim *dim);
+
+#endif				// SWEEP_H
@@ -0,0 +1,25 @@
+#!/bin/sh
+# MLFQ with one level and no boost is RR: checks that both print the same
+# table for every trace the RR test uses, at a few quanta. Run from the
+# SchedSim directory.
+
+status=0
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+for expected in tests/*.rr.expected; do
+    name=$(basename "$expected" .rr.expected)
+    input=tests/$name.txt
+    [ -f "$input" ] || input=$name.txt
+    for q in 1 2 5; do
+        ./schedsim -q $q -p rr "$input" 2>/dev/null | sed 1,3d > "$tmp/rr"
+        ./schedsim -q $q -p mlfq --mlfq-levels=1 --mlfq-boost=0 "$input" 2>/dev/null | sed 1,3d > "$tmp/mlfq"
+        if diff -u "$tmp/rr" "$tmp/mlfq" > /dev/null; then
+            echo "PASS $name q=$q"
+        else
+            echo "FAIL $name q=$q"
+            diff -u "$tmp/rr" "$tmp/mlfq"
+            status=1
+        fi
+    done
+done
+exit $status
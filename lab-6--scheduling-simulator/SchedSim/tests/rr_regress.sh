@@ -0,0 +1,19 @@
+#!/bin/sh
+# Compares the RR section of ./schedsim against output recorded from
+# schedsim_ref_with_arrival (quantum 2), up to the averages the reference
+# prints. Run from the SchedSim directory.
+
+status=0
+for expected in tests/*.rr.expected; do
+    name=$(basename "$expected" .rr.expected)
+    input=tests/$name.txt
+    [ -f "$input" ] || input=$name.txt
+    if ./schedsim "$input" | sed -n '/^RR Quantum/,/^Average turn around/p' | diff -u "$expected" - > /dev/null; then
+        echo "PASS $name"
+    else
+        echo "FAIL $name"
+        ./schedsim "$input" | sed -n '/^RR Quantum/,/^Average turn around/p' | diff -u "$expected" -
+        status=1
+    fi
+done
+exit $status
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Invariants of --cpus runs over the RR test traces: the CPUs' busy time
+# adds up to the total burst time, and with a CPU per process nobody
+# waits. Run from the SchedSim directory.
+
+status=0
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+for expected in tests/*.rr.expected; do
+    name=$(basename "$expected" .rr.expected)
+    input=tests/$name.txt
+    [ -f "$input" ] || input=$name.txt
+    n=$(grep -c . "$input")
+    for cpus in 2 3 $n; do
+        ./schedsim --cpus=$cpus -p rr,sjf,mlfq,cfs "$input" 2>/dev/null > "$tmp/out"
+        # process rows have 4 fields, CPU rows 5 (runs of tabs split them)
+        if awk -F'\t+' -v all_idle=$([ $cpus = $n ] && echo 1 || echo 0) '
+            /^\*/ { if (bt != busy) bad = 1; bt = busy = 0 }
+            /^\t[0-9]/ && NF == 5 { bt += $3; if (all_idle && $4 != 0) bad = 1 }
+            /^\t[0-9]/ && NF == 6 { busy += $3 }
+            END { if (bt != busy) bad = 1; exit bad }' "$tmp/out"; then
+            echo "PASS $name cpus=$cpus"
+        else
+            echo "FAIL $name cpus=$cpus"
+            cat "$tmp/out"
+            status=1
+        fi
+    done
+done
+exit $status
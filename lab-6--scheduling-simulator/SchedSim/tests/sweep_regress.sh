@@ -0,0 +1,32 @@
+#!/bin/sh
+# Each --sweep row must match a separate run with the same parameters:
+# compares the CSV summaries (makespan through fairness) over the RR test
+# traces. Run from the SchedSim directory.
+
+status=0
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+for expected in tests/*.rr.expected; do
+    name=$(basename "$expected" .rr.expected)
+    input=tests/$name.txt
+    [ -f "$input" ] || input=$name.txt
+    ./schedsim --jobs=3 --sweep=quantum=1..4 --sweep=cpus=1,3 -p rr,sjf,mlfq,cfs \
+        --format=csv "$input" 2>/dev/null | sed 1d | cut -d, -f5-25 > "$tmp/sweep"
+    : > "$tmp/single"
+    for p in rr sjf mlfq cfs; do
+        for q in 1 2 3 4; do
+            for cpus in 1 3; do
+                ./schedsim -q $q --cpus=$cpus -p $p --format=csv "$input" 2>/dev/null |
+                    sed 1d | cut -d, -f5-25 >> "$tmp/single"
+            done
+        done
+    done
+    if diff -u "$tmp/single" "$tmp/sweep" > /dev/null; then
+        echo "PASS $name"
+    else
+        echo "FAIL $name"
+        diff -u "$tmp/single" "$tmp/sweep"
+        status=1
+    fi
+done
+exit $status
@@ -0,0 +1,34 @@
+#!/bin/sh
+# --timeline over the RR test traces: the report is unchanged, each
+# process's intervals add up to its burst time and the intervals on a CPU
+# never overlap. Run from the SchedSim directory.
+
+status=0
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+for expected in tests/*.rr.expected; do
+    name=$(basename "$expected" .rr.expected)
+    input=tests/$name.txt
+    [ -f "$input" ] || input=$name.txt
+    for cpus in 1 3; do
+        ./schedsim --cpus=$cpus -p rr,sjf,mlfq,cfs "$input" 2>/dev/null > "$tmp/plain"
+        ./schedsim --cpus=$cpus -p rr,sjf,mlfq,cfs --timeline="$tmp/json" \
+            "$input" 2>/dev/null > "$tmp/out"
+        # one "ts dur run cpu pid bt" line per interval, in recording order
+        sed -n 's/.*"ts": \([0-9]*\), "dur": \([0-9]*\), "pid": \([0-9]*\), "tid": \([0-9]*\), "args": {"pid": \([0-9-]*\), "bt": \([0-9]*\).*/\1 \2 \3 \4 \5 \6/p' \
+            "$tmp/json" > "$tmp/iv"
+        if cmp -s "$tmp/plain" "$tmp/out" &&
+            [ -s "$tmp/iv" ] &&
+            awk '
+                { ran[$3 " " $5] += $2; bt[$3 " " $5] = $6
+                  if ($1 < free[$3 " " $4]) bad = 1
+                  free[$3 " " $4] = $1 + $2 }
+                END { for (k in ran) if (ran[k] != bt[k]) bad = 1; exit bad }' "$tmp/iv"; then
+            echo "PASS $name cpus=$cpus"
+        else
+            echo "FAIL $name cpus=$cpus"
+            status=1
+        fi
+    done
+done
+exit $status
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "timeline.h"
+#include "sched.h"
+
+Timeline *timeline_new(int ncpus)
+{
+    Timeline *tl = (Timeline *) xmalloc(sizeof(Timeline), "timeline_new");
+    tl->ncpus = ncpus;
+    tl->head = (TimelineChunk **) xmalloc(ncpus * sizeof(TimelineChunk *), "timeline_new");
+    tl->tail = (TimelineChunk **) xmalloc(ncpus * sizeof(TimelineChunk *), "timeline_new");
+    for (int c = 0; c < ncpus; c++)
+        tl->head[c] = tl->tail[c] = NULL;
+    tl->count = 0;
+    return tl;
+}
+
+void timeline_free(Timeline *tl)
+{
+    if (!tl)
+        return;
+    for (int c = 0; c < tl->ncpus; c++) {
+        TimelineChunk *chunk = tl->head[c];
+        while (chunk) {
+            TimelineChunk *next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+    }
+    free(tl->head);
+    free(tl->tail);
+    free(tl);
+}
+
+void timeline_add(Timeline *tl, int cpu, int proc, long long start, long long end)
+{
+    TimelineChunk *chunk = tl->tail[cpu];
+
+    if (!chunk || chunk->count == TIMELINE_CHUNK) {
+        TimelineChunk *fresh = (TimelineChunk *) xmalloc(sizeof(TimelineChunk), "timeline_add");
+        fresh->next = NULL;
+        fresh->count = 0;
+        if (chunk)
+            chunk->next = fresh;
+        else
+            tl->head[cpu] = fresh;
+        tl->tail[cpu] = chunk = fresh;
+    }
+    chunk->rec[chunk->count].start = start;
+    chunk->rec[chunk->count].len = (int)(end - start);
+    chunk->rec[chunk->count].proc = proc;
+    chunk->count++;
+    tl->count++;
+}
+
+void timeline_write_begin(FILE *out)
+{
+    fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+}
+
+void timeline_write_run(FILE *out, const Timeline *tl, int run, const char *name,
+                        const char *title, const ProcessType plist[], int first)
+{
+    // metadata: the run is a process named after the policy, CPUs are threads
+    fprintf(out, "%s\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, "
+            "\"args\": {\"name\": \"%s\"}}", first ? "" : ",", run, title);
+    fprintf(out, ",\n{\"name\": \"process_sort_index\", \"ph\": \"M\", \"pid\": %d, "
+            "\"args\": {\"sort_index\": %d}}", run, run);
+    for (int c = 0; c < tl->ncpus; c++)
+        fprintf(out, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"name\": \"CPU %d\"}}", run, c, c);
+
+    for (int c = 0; c < tl->ncpus; c++) {
+        for (const TimelineChunk *chunk = tl->head[c]; chunk; chunk = chunk->next) {
+            for (int k = 0; k < chunk->count; k++) {
+                const Interval *iv = &chunk->rec[k];
+                const ProcessType *p = &plist[iv->proc];
+                fprintf(out, ",\n{\"name\": \"P%d\", \"cat\": \"%s\", \"ph\": \"X\", "
+                        "\"ts\": %lld, \"dur\": %d, \"pid\": %d, \"tid\": %d, "
+                        "\"args\": {\"pid\": %d, \"bt\": %d, \"art\": %d, \"pri\": %d}}",
+                        p->pid, name, iv->start, iv->len, run, c,
+                        p->pid, p->bt, p->art, p->pri);
+            }
+        }
+    }
+}
+
+void timeline_write_end(FILE *out)
+{
+    fprintf(out, "\n]}\n");
+}
@@ -0,0 +1,51 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdio.h>
+#include "process.h"
+
+/**
+ * Run intervals of one simulation: which process ran on which CPU, and
+ * when. Each CPU appends to its own list of fixed-size chunks, so a
+ * record is 16 bytes, the CPU is implied by the list, and nothing is
+ * ever copied as the timeline grows. simulate records into
+ * res->timeline only when it is set; a NULL timeline costs one branch
+ * per segment.
+ */
+
+#define TIMELINE_CHUNK 4096
+
+typedef struct Interval {
+    long long start;
+    int len;
+    int proc; // plist index
+} Interval;
+
+typedef struct TimelineChunk {
+    struct TimelineChunk *next;
+    int count;
+    Interval rec[TIMELINE_CHUNK];
+} TimelineChunk;
+
+typedef struct Timeline {
+    int ncpus;
+    TimelineChunk **head; // per CPU, oldest chunk first
+    TimelineChunk **tail;
+    long long count; // intervals over all CPUs
+} Timeline;
+
+Timeline *timeline_new(int ncpus);
+void timeline_free(Timeline *tl);
+
+// Appends the interval [start, end) of process proc on cpu
+void timeline_add(Timeline *tl, int cpu, int proc, long long start, long long end);
+
+// Chrome trace-event JSON, for Perfetto or chrome://tracing: begin, one
+// timeline_write_run per policy run, then end. Each run shows as its own
+// process named title with one thread per CPU; one time unit is 1 us.
+void timeline_write_begin(FILE *out);
+void timeline_write_run(FILE *out, const Timeline *tl, int run, const char *name,
+                        const char *title, const ProcessType plist[], int first);
+void timeline_write_end(FILE *out);
+
+#endif				// TIMELINE_H
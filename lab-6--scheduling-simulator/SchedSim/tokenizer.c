@@ -0,0 +1,128 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "tokenizer.h"
+
+int tok_open(Tokenizer *tk, const char *path)
+{
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return -1;
+    }
+    tk->size = st.st_size;
+    tk->base = NULL;
+    if (tk->size > 0) {
+        void *map = mmap(NULL, tk->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        madvise(map, tk->size, MADV_SEQUENTIAL);
+        tk->base = (const char *)map;
+    }
+    close(fd); // the mapping stays valid
+    tk->p = tk->base;
+    tk->line = 1;
+    tk->path = path;
+    clock_gettime(CLOCK_MONOTONIC, &tk->start);
+    return 0;
+}
+
+void tok_close(Tokenizer *tk)
+{
+    if (tk->base)
+        munmap((void *)tk->base, tk->size);
+    tk->base = tk->p = NULL;
+    tk->size = 0;
+}
+
+static void tok_error(const Tokenizer *tk, const char *msg)
+{
+    fprintf(stderr, "Error: %s:%d: %s\n", tk->path, tk->line, msg);
+    exit(1);
+}
+
+int tok_next_int(Tokenizer *tk, int *value)
+{
+    const char *p = tk->p;
+    const char *end = tk->base + tk->size;
+    int neg = 0;
+    long long v = 0;
+
+    for (; p < end; p++) {
+        if (*p == '\n')
+            tk->line++;
+        else if (*p != ' ' && *p != '\t' && *p != '\r')
+            break;
+    }
+    if (p == end) {
+        tk->p = p;
+        return 0;
+    }
+
+    if (*p == '-' || *p == '+') {
+        neg = (*p == '-');
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        tk->p = p;
+        tok_error(tk, "expected an integer");
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        if (v > (long long)INT_MAX + 1) {
+            tk->p = p;
+            tok_error(tk, "integer out of range");
+        }
+    }
+    if (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        tk->p = p;
+        tok_error(tk, "expected an integer");
+    }
+    if (neg)
+        v = -v;
+    if (v > INT_MAX)
+        tok_error(tk, "integer out of range");
+
+    tk->p = p;
+    *value = (int)v;
+    return 1;
+}
+
+void tok_reserve(void **buf, size_t *cap, size_t need, size_t elem_size)
+{
+    if (need <= *cap)
+        return;
+    size_t ncap = *cap ? *cap : 1024;
+    while (ncap < need)
+        ncap *= 2;
+    void *nbuf = realloc(*buf, ncap * elem_size);
+    if (!nbuf) {
+        fprintf(stderr, "Fatal: realloc failed in tok_reserve\n");
+        exit(1);
+    }
+    *buf = nbuf;
+    *cap = ncap;
+}
+
+void tok_report(const Tokenizer *tk, const char *what)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double secs = (now.tv_sec - tk->start.tv_sec) + (now.tv_nsec - tk->start.tv_nsec) / 1e9;
+    double mb = tk->size / 1e6;
+
+    fprintf(stderr, "%s: parsed %.1f MB in %.3f s (%.1f MB/s)\n",
+            what, mb, secs, secs > 0 ? mb / secs : 0.0);
+}
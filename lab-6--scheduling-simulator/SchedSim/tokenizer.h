@@ -0,0 +1,38 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * Memory-mapped integer tokenizer shared by the SchedSim and MMU parsers.
+ * The whole input file is mapped read-only and scanned once, integer by
+ * integer; whitespace (including newlines) only separates numbers.
+ */
+
+typedef struct Tokenizer {
+    const char *base; // mapped file, NULL for an empty file
+    size_t size;
+    const char *p; // scan cursor
+    int line; // line of the cursor, for error messages
+    const char *path;
+    struct timespec start;
+} Tokenizer;
+
+// Maps the file; returns 0, or -1 if it cannot be opened or mapped
+int tok_open(Tokenizer *tk, const char *path);
+void tok_close(Tokenizer *tk);
+
+// Reads the next integer into *value. Returns 1 on success and 0 at end of
+// file; anything that is not an int exits with an error naming the line.
+int tok_next_int(Tokenizer *tk, int *value);
+
+// Makes room for at least need elements of elem_size bytes in *buf, which
+// holds *cap elements, by doubling; exits if memory runs out.
+void tok_reserve(void **buf, size_t *cap, size_t need, size_t elem_size);
+
+// Prints size, time since tok_open and MB/s to stderr, labelled with what.
+// txt2bin always reports; schedsim and the MMU only with PARSE_STATS set
+void tok_report(const Tokenizer *tk, const char *what);
+
+#endif				// TOKENIZER_H
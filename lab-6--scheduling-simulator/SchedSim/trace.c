@@ -0,0 +1,124 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+
+// Records are used in place, so ProcessType must be exactly the record
+typedef char trace_record_check[sizeof(ProcessType) == TRACE_FIELDS * 4 ? 1 : -1];
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+static uint32_t le32(const unsigned char *b)
+{
+    return b[0] | b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+#endif
+
+static void trace_error(const char *path, const char *msg)
+{
+    fprintf(stderr, "Error: %s: %s\n", path, msg);
+    exit(1);
+}
+
+int trace_map(const char *path, Trace *t)
+{
+    struct stat st;
+    TraceHeader h;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        close(fd);
+        trace_error(path, "not a binary trace (too short)");
+    }
+    t->size = st.st_size;
+    t->base = mmap(NULL, t->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid
+    if (t->base == MAP_FAILED)
+        trace_error(path, "mmap failed");
+    madvise(t->base, t->size, MADV_SEQUENTIAL);
+    t->copy = NULL;
+
+    memcpy(&h, t->base, sizeof(h));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    h.version = le32((const unsigned char *)&h.version);
+    h.fields = le32((const unsigned char *)&h.fields);
+    h.count = le32((const unsigned char *)&h.count) |
+        (uint64_t)le32((const unsigned char *)&h.count + 4) << 32;
+#endif
+    if (memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0)
+        trace_error(path, "not a binary trace (bad magic)");
+    if (h.version != TRACE_VERSION || h.fields != TRACE_FIELDS)
+        trace_error(path, "unsupported trace version or record layout");
+    size_t body = t->size - sizeof(TraceHeader);
+    if (h.count > INT_MAX || body % sizeof(ProcessType) != 0 ||
+        body / sizeof(ProcessType) != h.count)
+        trace_error(path, "file size does not match the record count");
+
+    t->n = (int)h.count;
+    t->plist = (const ProcessType *)((const char *)t->base + sizeof(TraceHeader));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    t->copy = (ProcessType *) malloc((t->n ? t->n : 1) * sizeof(ProcessType));
+    if (!t->copy) {
+        fprintf(stderr, "Fatal: malloc failed in trace_map\n");
+        exit(1);
+    }
+    for (int i = 0; i < t->n; i++) {
+        const unsigned char *r = (const unsigned char *)&t->plist[i];
+        t->copy[i].pid = (int32_t)le32(r);
+        t->copy[i].bt = (int32_t)le32(r + 4);
+        t->copy[i].art = (int32_t)le32(r + 8);
+        t->copy[i].wt = (int32_t)le32(r + 12);
+        t->copy[i].tat = (int32_t)le32(r + 16);
+        t->copy[i].pri = (int32_t)le32(r + 20);
+    }
+    t->plist = t->copy;
+#endif
+    return 0;
+}
+
+void trace_unmap(Trace *t)
+{
+    free(t->copy);
+    munmap(t->base, t->size);
+    t->plist = NULL;
+    t->copy = NULL;
+    t->base = NULL;
+    t->n = 0;
+}
+
+static void put_le32(unsigned char *b, uint32_t v)
+{
+    b[0] = v;
+    b[1] = v >> 8;
+    b[2] = v >> 16;
+    b[3] = v >> 24;
+}
+
+void trace_write_header(FILE *out, uint64_t count)
+{
+    unsigned char b[sizeof(TraceHeader)];
+
+    memcpy(b, TRACE_MAGIC, 8);
+    put_le32(b + 8, TRACE_VERSION);
+    put_le32(b + 12, TRACE_FIELDS);
+    put_le32(b + 16, (uint32_t)count);
+    put_le32(b + 20, (uint32_t)(count >> 32));
+    fwrite(b, sizeof(b), 1, out);
+}
+
+void trace_write_record(FILE *out, const int v[])
+{
+    unsigned char rec[TRACE_FIELDS * 4];
+
+    for (int k = 0; k < TRACE_FIELDS; k++)
+        put_le32(rec + 4 * k, (uint32_t)v[k]);
+    fwrite(rec, sizeof(rec), 1, out);
+}
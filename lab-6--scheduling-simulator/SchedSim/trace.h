@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "process.h"
+
+/**
+ * Binary trace format for ProcessType records.
+ *
+ * A 24-byte header followed by count records. Every field is
+ * little endian. A record is TRACE_FIELDS 32-bit signed integers in
+ * ProcessType order (pid bt art wt tat pri), so on a little-endian host
+ * the records can be used in place as a ProcessType array.
+ */
+
+#define TRACE_MAGIC "SCHEDTRC" // 8 bytes, no terminator in the file
+#define TRACE_VERSION 1 // field layout version
+#define TRACE_FIELDS 6
+
+typedef struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t fields; // int32 fields per record
+    uint64_t count; // number of records
+} TraceHeader;
+
+// A mapped trace. plist points into the mapping on little-endian hosts;
+// elsewhere it is a byte-swapped copy.
+typedef struct Trace {
+    const ProcessType *plist;
+    int n;
+    void *base; // mapping of the whole file
+    size_t size;
+    ProcessType *copy; // only on big-endian hosts
+} Trace;
+
+// Maps a binary trace into *t without copying the records. Returns 0, or
+// -1 if the file cannot be opened; exits if it is not a valid trace.
+int trace_map(const char *path, Trace *t);
+void trace_unmap(Trace *t);
+
+// Writer side: a header for count records, then count records of
+// TRACE_FIELDS values each
+void trace_write_header(FILE *out, uint64_t count);
+void trace_write_record(FILE *out, const int v[]);
+
+#endif				// TRACE_H
@@ -0,0 +1,275 @@
+// Generates synthetic SchedSim traces, text or binary (trace.h).
+//
+// Arrivals follow a Poisson process: exponential interarrival times at
+// --rate processes per time unit. Bursts are exponential, heavy-tailed
+// Pareto or bimodal, and priorities are drawn from a weighted mix. All
+// draws come from one seeded generator, so a seed always gives the same
+// trace. Records are written as they are drawn, so traces of any size
+// need no memory.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <getopt.h>
+
+#include "trace.h"
+
+#define MAX_BURST 1000000
+#define MAX_PRI_CLASSES 40
+
+typedef enum BurstKind {
+    BURST_EXP,
+    BURST_PARETO,
+    BURST_BIMODAL
+} BurstKind;
+
+typedef struct BurstDist {
+    BurstKind kind;
+    double a, b, c; // exp: mean; pareto: alpha, min; bimodal: short, long, p(long)
+} BurstDist;
+
+typedef struct PriMix {
+    int pri[MAX_PRI_CLASSES];
+    double cum[MAX_PRI_CLASSES]; // cumulative weights
+    int count;
+} PriMix;
+
+// splitmix64: tiny, fast and good enough for workload shapes
+static uint64_t rng_state;
+
+static uint64_t rng_next(void)
+{
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform in (0, 1], so log() never sees 0
+static double rng_unit(void)
+{
+    return ((rng_next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+static double rng_exp(double mean)
+{
+    return -mean * log(rng_unit());
+}
+
+static int draw_burst(const BurstDist *d)
+{
+    double x = 0.0;
+
+    switch (d->kind) {
+    case BURST_EXP:
+        x = rng_exp(d->a);
+        break;
+    case BURST_PARETO:
+        x = d->b / pow(rng_unit(), 1.0 / d->a);
+        break;
+    case BURST_BIMODAL:
+        x = rng_unit() <= d->c ? d->b : d->a;
+        break;
+    }
+    if (x < 1.0)
+        return 1;
+    if (x > MAX_BURST)
+        return MAX_BURST;
+    return (int)x;
+}
+
+static int draw_pri(const PriMix *mix)
+{
+    double u = rng_unit() * mix->cum[mix->count - 1];
+    int k = 0;
+    while (k < mix->count - 1 && u > mix->cum[k])
+        k++;
+    return mix->pri[k];
+}
+
+static double num_arg(const char *what, const char *arg, double min)
+{
+    char *end;
+    double v = strtod(arg, &end);
+    if (end == arg || *end != '\0' || !(v >= min)) {
+        fprintf(stderr, "Error: %s must be a number of at least %g\n", what, min);
+        exit(1);
+    }
+    return v;
+}
+
+// "exp:MEAN", "pareto:ALPHA:MIN" or "bimodal:SHORT:LONG:PLONG"
+static void parse_burst(char *spec, BurstDist *d)
+{
+    char *kind = strtok(spec, ":");
+    char *f[3];
+    int nf = 0, want;
+
+    while (nf < 3 && (f[nf] = strtok(NULL, ":")) != NULL)
+        nf++;
+    if (kind && strcmp(kind, "exp") == 0) {
+        d->kind = BURST_EXP;
+        want = 1;
+    } else if (kind && strcmp(kind, "pareto") == 0) {
+        d->kind = BURST_PARETO;
+        want = 2;
+    } else if (kind && strcmp(kind, "bimodal") == 0) {
+        d->kind = BURST_BIMODAL;
+        want = 3;
+    } else {
+        fprintf(stderr, "Error: burst must be exp:MEAN, pareto:ALPHA:MIN or bimodal:SHORT:LONG:PLONG\n");
+        exit(1);
+    }
+    if (nf != want || strtok(NULL, ":")) {
+        fprintf(stderr, "Error: burst %s takes %d parameter(s)\n", kind, want);
+        exit(1);
+    }
+    switch (d->kind) {
+    case BURST_EXP:
+        d->a = num_arg("exp mean", f[0], 1.0);
+        break;
+    case BURST_PARETO:
+        d->a = num_arg("pareto alpha", f[0], 0.01);
+        d->b = num_arg("pareto min", f[1], 1.0);
+        break;
+    case BURST_BIMODAL:
+        d->a = num_arg("bimodal short", f[0], 1.0);
+        d->b = num_arg("bimodal long", f[1], 1.0);
+        d->c = num_arg("bimodal plong", f[2], 0.0);
+        if (d->c > 1.0) {
+            fprintf(stderr, "Error: bimodal plong must be at most 1\n");
+            exit(1);
+        }
+        break;
+    }
+}
+
+// Comma separated PRI:WEIGHT pairs
+static void parse_pri(char *spec, PriMix *mix)
+{
+    double total = 0.0;
+
+    mix->count = 0;
+    for (char *item = strtok(spec, ","); item; item = strtok(NULL, ",")) {
+        char *colon = strchr(item, ':');
+        if (mix->count == MAX_PRI_CLASSES) {
+            fprintf(stderr, "Error: at most %d priority classes\n", MAX_PRI_CLASSES);
+            exit(1);
+        }
+        if (!colon) {
+            fprintf(stderr, "Error: priority mix items are PRI:WEIGHT, not %s\n", item);
+            exit(1);
+        }
+        *colon = '\0';
+        mix->pri[mix->count] = atoi(item);
+        total += num_arg("a priority weight", colon + 1, 0.0);
+        mix->cum[mix->count++] = total;
+    }
+    if (mix->count == 0 || total <= 0.0) {
+        fprintf(stderr, "Error: the priority mix needs a positive weight\n");
+        exit(1);
+    }
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: ./tracegen [--count=N] [--seed=N] [--rate=R]\n"
+            "                  [--burst=exp:MEAN|pareto:ALPHA:MIN|bimodal:SHORT:LONG:PLONG]\n"
+            "                  [--pri=P:W,...] [--binary] [--output=file]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option long_opts[] = {
+        {"count", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 's'},
+        {"rate", required_argument, NULL, 'r'},
+        {"burst", required_argument, NULL, 'B'},
+        {"pri", required_argument, NULL, 'P'},
+        {"binary", no_argument, NULL, 'b'},
+        {"output", required_argument, NULL, 'o'},
+        {NULL, 0, NULL, 0}
+    };
+    BurstDist burst = { BURST_EXP, 8.0, 0.0, 0.0 };
+    PriMix mix;
+    char pri_default[] = "0:70,1:20,2:10";
+    const char *path = NULL;
+    long long count = 10000;
+    double rate = 0.1, clock = 0.0;
+    int binary = 0, c;
+    FILE *out = stdout;
+
+    rng_state = 1;
+    parse_pri(pri_default, &mix);
+    while ((c = getopt_long(argc, argv, "n:s:r:bo:", long_opts, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            count = atoll(optarg);
+            if (count < 1 || count > INT_MAX) {
+                fprintf(stderr, "Error: count must be between 1 and %d\n", INT_MAX);
+                return 1;
+            }
+            break;
+        case 's':
+            rng_state = strtoull(optarg, NULL, 0);
+            break;
+        case 'r':
+            rate = num_arg("rate", optarg, 1e-9);
+            break;
+        case 'B':
+            parse_burst(optarg, &burst);
+            break;
+        case 'P':
+            parse_pri(optarg, &mix);
+            break;
+        case 'b':
+            binary = 1;
+            break;
+        case 'o':
+            path = optarg;
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (optind != argc) {
+        usage();
+        return 1;
+    }
+    if (path && !(out = fopen(path, binary ? "wb" : "w"))) {
+        fprintf(stderr, "Error: cannot create %s\n", path);
+        return 1;
+    }
+
+    if (binary)
+        trace_write_header(out, (uint64_t)count);
+    for (long long k = 0; k < count; k++) {
+        int rec[TRACE_FIELDS];
+
+        // the first process arrives at 0, the rest after exponential gaps
+        if (k > 0)
+            clock += rng_exp(1.0 / rate);
+        if (clock > INT_MAX) {
+            fprintf(stderr, "Error: arrivals pass %d after %lld processes; raise --rate\n",
+                    INT_MAX, k);
+            return 1;
+        }
+        rec[0] = (int)(k + 1);
+        rec[1] = draw_burst(&burst);
+        rec[2] = (int)clock;
+        rec[3] = 0;
+        rec[4] = 0;
+        rec[5] = draw_pri(&mix);
+        if (binary)
+            trace_write_record(out, rec);
+        else
+            fprintf(out, "%d %d %d 0 0 %d\n", rec[0], rec[1], rec[2], rec[5]);
+    }
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Error: writing %s failed\n", path ? path : "the trace");
+        return 1;
+    }
+    return 0;
+}
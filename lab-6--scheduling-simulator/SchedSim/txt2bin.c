@@ -0,0 +1,60 @@
+// Converts a SchedSim text trace into the binary trace format (trace.h).
+// The text file is tokenized in one streaming pass, so traces larger than
+// memory convert fine.
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "trace.h"
+#include "tokenizer.h"
+
+int main(int argc, char *argv[])
+{
+    Tokenizer tk;
+    FILE *out;
+    int rec[TRACE_FIELDS];
+    uint64_t count = 0;
+    int v, k = 0;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: ./txt2bin <input-file-path> <output-file-path>\n");
+        return 1;
+    }
+    if (tok_open(&tk, argv[1]) < 0) {
+        fprintf(stderr, "Error: Invalid filepath\n");
+        return 1;
+    }
+    out = fopen(argv[2], "wb");
+    if (!out) {
+        fprintf(stderr, "Error: cannot create %s\n", argv[2]);
+        return 1;
+    }
+
+    trace_write_header(out, 0); // count is filled in at the end
+    while (tok_next_int(&tk, &v)) {
+        rec[k] = v;
+        if (++k < TRACE_FIELDS)
+            continue;
+        k = 0;
+        if (count == INT_MAX) {
+            fprintf(stderr, "Error: %s: too many processes\n", argv[1]);
+            return 1;
+        }
+        trace_write_record(out, rec);
+        count++;
+    }
+    if (k != 0) {
+        fprintf(stderr, "Error: %s: incomplete process record at end of file\n", argv[1]);
+        return 1;
+    }
+
+    rewind(out);
+    trace_write_header(out, count);
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Error: writing %s failed\n", argv[2]);
+        return 1;
+    }
+    tok_report(&tk, argv[1]);
+    tok_close(&tk);
+    printf("%llu processes written to %s\n", (unsigned long long)count, argv[2]);
+    return 0;
+}
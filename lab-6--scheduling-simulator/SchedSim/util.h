@@ -7,6 +7,6 @@
  * Utility function file
  */
 
-ProcessType *parse_file(FILE *, int *);
+ProcessType *parse_file(const char *, int *);
 
-#endif				// UTIL_H
\ No newline at end of file
+#endif				// UTIL_H
@@ -0,0 +1,275 @@
+// MMU/blktree.c
+// AVL tree over free-list order, augmented with subtree block sizes.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "blktree.h"
+
+#define BLK_SIZE(b) (((b)->end - (b)->start) + 1)
+
+typedef struct blknode bnode_t;
+
+static int height(bnode_t *n) {
+    return n ? n->height : 0;
+}
+
+/* Recomputes n's height and size range from its children. */
+static void update(bnode_t *n) {
+    int hl = height(n->left), hr = height(n->right);
+    n->height = (hl > hr ? hl : hr) + 1;
+    n->min = n->max = n->size;
+    if (n->left) {
+        if (n->left->min < n->min) n->min = n->left->min;
+        if (n->left->max > n->max) n->max = n->left->max;
+    }
+    if (n->right) {
+        if (n->right->min < n->min) n->min = n->right->min;
+        if (n->right->max > n->max) n->max = n->right->max;
+    }
+}
+
+static bnode_t *rotate_right(bnode_t *n) {
+    bnode_t *l = n->left;
+    n->left = l->right;
+    l->right = n;
+    update(n);
+    update(l);
+    return l;
+}
+
+static bnode_t *rotate_left(bnode_t *n) {
+    bnode_t *r = n->right;
+    n->right = r->left;
+    r->left = n;
+    update(n);
+    update(r);
+    return r;
+}
+
+/* Restores the AVL balance at n after one of its subtrees changed height
+ * by at most one; returns the subtree's new root. */
+static bnode_t *rebalance(bnode_t *n) {
+    int balance = height(n->left) - height(n->right);
+
+    if (balance > 1) {
+        if (height(n->left->left) < height(n->left->right))
+            n->left = rotate_left(n->left);
+        return rotate_right(n);
+    }
+    if (balance < -1) {
+        if (height(n->right->right) < height(n->right->left))
+            n->right = rotate_right(n->right);
+        return rotate_left(n);
+    }
+    update(n);
+    return n;
+}
+
+/* A block sized in [lo, hi] matches; with one bound open, the subtree size
+ * range tells exactly whether any block in it matches. */
+static int node_matches(bnode_t *n, long long lo, long long hi) {
+    return n->size >= lo && n->size <= hi;
+}
+
+static int subtree_matches(bnode_t *n, long long lo, long long hi) {
+    return n != NULL && n->max >= lo && n->min <= hi;
+}
+
+static bnode_t *insert_last(bnode_t *n, bnode_t *e) {
+    if (n == NULL) return e;
+    n->right = insert_last(n->right, e);
+    return rebalance(n);
+}
+
+/* Links e before the first node in order that matches, or at the end. */
+static bnode_t *insert_before_match(bnode_t *n, bnode_t *e, long long lo, long long hi) {
+    if (n == NULL) return e;
+    if (subtree_matches(n->left, lo, hi))
+        n->left = insert_before_match(n->left, e, lo, hi);
+    else if (node_matches(n, lo, hi))
+        n->left = insert_last(n->left, e);
+    else
+        n->right = insert_before_match(n->right, e, lo, hi);
+    return rebalance(n);
+}
+
+static bnode_t *pop_first(bnode_t *n, bnode_t **first) {
+    if (n->left == NULL) {
+        *first = n;
+        return n->right;
+    }
+    n->left = pop_first(n->left, first);
+    return rebalance(n);
+}
+
+/* Unlinks n, its in-order successor taking its place. */
+static bnode_t *unlink_node(bnode_t *n) {
+    bnode_t *succ;
+    if (n->left == NULL) return n->right;
+    if (n->right == NULL) return n->left;
+    n->right = pop_first(n->right, &succ);
+    succ->left = n->left;
+    succ->right = n->right;
+    return rebalance(succ);
+}
+
+/* Unlinks the first node in order that matches; the subtree must have one. */
+static bnode_t *remove_first_match(bnode_t *n, long long lo, long long hi, bnode_t **out) {
+    if (subtree_matches(n->left, lo, hi)) {
+        n->left = remove_first_match(n->left, lo, hi, out);
+    } else if (node_matches(n, lo, hi)) {
+        *out = n;
+        return unlink_node(n);
+    } else {
+        n->right = remove_first_match(n->right, lo, hi, out);
+    }
+    return rebalance(n);
+}
+
+static bnode_t *bnode_alloc(block_t *blk) {
+    bnode_t *n = (bnode_t*) malloc(sizeof(bnode_t));
+    if (n == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in bnode_alloc\n");
+        exit(1);
+    }
+    n->blk = blk;
+    n->size = BLK_SIZE(blk);
+    n->left = n->right = NULL;
+    update(n);
+    return n;
+}
+
+blktree_t *blktree_alloc() {
+    blktree_t *t = (blktree_t*) malloc(sizeof(blktree_t));
+    if (t == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in blktree_alloc\n");
+        exit(1);
+    }
+    t->root = NULL;
+    t->length = 0;
+    return t;
+}
+
+static void free_nodes(bnode_t *n) {
+    if (n == NULL) return;
+    free_nodes(n->left);
+    free_nodes(n->right);
+    free(n->blk);
+    free(n);
+}
+
+void blktree_free(blktree_t *t) {
+    if (t == NULL) return;
+    free_nodes(t->root);
+    free(t);
+}
+
+/* Ties go after existing blocks of equal size, as in the list */
+void blktree_add_ascending_by_blocksize(blktree_t *t, block_t *blk) {
+    bnode_t *e = bnode_alloc(blk);
+    t->root = insert_before_match(t->root, e, (long long)e->size + 1, INT_MAX);
+    t->length++;
+}
+
+/* Ties go before existing blocks of equal size, as in the list */
+void blktree_add_descending_by_blocksize(blktree_t *t, block_t *blk) {
+    bnode_t *e = bnode_alloc(blk);
+    t->root = insert_before_match(t->root, e, INT_MIN, e->size);
+    t->length++;
+}
+
+block_t *blktree_remove_first_by_size(blktree_t *t, int size) {
+    bnode_t *n;
+    block_t *blk;
+
+    if (!subtree_matches(t->root, size, INT_MAX))
+        return NULL;
+    t->root = remove_first_match(t->root, size, INT_MAX, &n);
+    t->length--;
+    blk = n->blk;
+    free(n);
+    return blk;
+}
+
+static void collect(bnode_t *n, bnode_t **nodes, int *i) {
+    if (n == NULL) return;
+    collect(n->left, nodes, i);
+    nodes[(*i)++] = n;
+    collect(n->right, nodes, i);
+}
+
+/* Balanced tree over nodes[lo..hi) in that order */
+static bnode_t *build(bnode_t **nodes, int lo, int hi) {
+    if (lo >= hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    bnode_t *n = nodes[mid];
+    n->left = build(nodes, lo, mid);
+    n->right = build(nodes, mid + 1, hi);
+    update(n);
+    return n;
+}
+
+/* Address order; equal addresses (empty blocks) end up in reverse list
+ * order, as list_add_ascending_by_address leaves them. The list position
+ * is parked in height until the tree is rebuilt. */
+static int by_address(const void *a, const void *b) {
+    const bnode_t *x = *(bnode_t * const *)a;
+    const bnode_t *y = *(bnode_t * const *)b;
+    if (x->blk->start != y->blk->start)
+        return (x->blk->start > y->blk->start) - (x->blk->start < y->blk->start);
+    return y->height - x->height;
+}
+
+void blktree_coalesce(blktree_t *t) {
+    int n = t->length, m = 0, i = 0;
+    bnode_t **nodes;
+
+    if (n == 0) return;
+    nodes = (bnode_t**) malloc(n * sizeof(bnode_t*));
+    if (nodes == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in blktree_coalesce\n");
+        exit(1);
+    }
+    collect(t->root, nodes, &i);
+    for (i = 0; i < n; i++)
+        nodes[i]->height = i;
+    qsort(nodes, n, sizeof(bnode_t*), by_address);
+
+    for (i = 1; i < n; i++) {
+        block_t *run = nodes[m]->blk;
+        if (run->end + 1 == nodes[i]->blk->start) {
+            run->end = nodes[i]->blk->end;
+            free(nodes[i]->blk);
+            free(nodes[i]);
+        } else {
+            nodes[++m] = nodes[i];
+        }
+    }
+    m++;
+    for (i = 0; i < m; i++)
+        nodes[i]->size = BLK_SIZE(nodes[i]->blk);
+    t->root = build(nodes, 0, m);
+    t->length = m;
+    free(nodes);
+}
+
+/* AVL height stays under 1.45 log2(n + 2), so this covers any int length */
+#define BLKTREE_MAX_HEIGHT 48
+
+void blktree_walk(blktree_t *t, void (*visit)(block_t *, void *), void *arg) {
+    bnode_t *stack[BLKTREE_MAX_HEIGHT], *n;
+    int top = 0;
+
+    if (t == NULL) return;
+    n = t->root;
+    while (n != NULL || top > 0) {
+        while (n != NULL) {
+            stack[top++] = n;
+            n = n->left;
+        }
+        n = stack[--top];
+        visit(n->blk, arg);
+        n = n->right;
+    }
+}
@@ -0,0 +1,59 @@
+// MMU/blktree.h
+//
+// Balanced-tree index of free blocks for best-fit and worst-fit. The tree
+// is an AVL tree over the free list's order (an in-order walk visits the
+// blocks exactly as the sorted free list would hold them), and every node
+// also keeps the smallest and largest block size in its subtree. Both the
+// fit search ("first block of at least size") and the sorted inserts
+// ("before the first larger / not larger block") then follow one path from
+// the root, O(log n), instead of walking the list.
+//
+// Because the order is the list's own, the picks and the printed order
+// match the list versions of best-fit and worst-fit exactly, including
+// after a coalesce leaves the blocks in address order.
+//
+// <Author>
+
+#ifndef BLKTREE_H
+#define BLKTREE_H
+
+#include "list.h"
+
+struct blknode {
+	block_t *blk;
+	int size;                  /* of blk, fixed while it is in the tree */
+	int height;
+	int min, max;              /* block sizes over the subtree */
+	struct blknode *left;
+	struct blknode *right;
+};
+
+struct blktree {
+	struct blknode *root;
+	int length;
+};
+typedef struct blktree blktree_t;
+
+blktree_t *blktree_alloc();
+
+/* Frees the tree and every block still in it. */
+void blktree_free(blktree_t *t);
+
+/* Same placement as list_add_ascending_by_blocksize and
+ * list_add_descending_by_blocksize. */
+void blktree_add_ascending_by_blocksize(blktree_t *t, block_t *blk);
+void blktree_add_descending_by_blocksize(blktree_t *t, block_t *blk);
+
+/* Removes and returns the first block in order of at least size, or NULL
+ * if none is large enough. On an ascending tree this is the best fit, on a
+ * descending one the worst fit. */
+block_t *blktree_remove_first_by_size(blktree_t *t, int size);
+
+/* Orders the blocks by address and merges physically adjacent ones, like
+ * coalese_memory does for a list, in O(n log n). */
+void blktree_coalesce(blktree_t *t);
+
+/* Calls visit on every block in order. */
+void blktree_walk(blktree_t *t, void (*visit)(block_t *, void *), void *arg);
+
+#endif // BLKTREE_H
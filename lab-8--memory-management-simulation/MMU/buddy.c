@@ -0,0 +1,195 @@
+// MMU/buddy.c
+// Binary buddy allocator: per-order free lists plus a start address hash.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "buddy.h"
+
+typedef struct buddy_node bnode_t;
+
+/* Smallest order whose blocks hold size units; sizes below 1 get one unit */
+static int order_of(int size) {
+    return size > 1 ? 32 - __builtin_clz((unsigned int)(size - 1)) : 0;
+}
+
+int buddy_block_size(int size) {
+    return 1 << order_of(size);
+}
+
+static void *xcalloc(size_t n, size_t size, const char *where) {
+    void *p = calloc(n, size);
+    if (p == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in %s\n", where);
+        exit(1);
+    }
+    return p;
+}
+
+static unsigned int bucket(buddy_t *b, int start) {
+    /* Fibonacci hashing spreads the aligned, low-bit-poor addresses */
+    return ((unsigned int)start * 2654435769u) & (b->nbuckets - 1);
+}
+
+static void rehash(buddy_t *b) {
+    bnode_t **old = b->table;
+    int n = b->nbuckets;
+
+    b->nbuckets *= 2;
+    b->table = (bnode_t**) xcalloc(b->nbuckets, sizeof(bnode_t*), "buddy rehash");
+    for (int i = 0; i < n; i++) {
+        bnode_t *node = old[i];
+        while (node != NULL) {
+            bnode_t *next = node->hnext;
+            unsigned int h = bucket(b, node->blk->start);
+            node->hnext = b->table[h];
+            b->table[h] = node;
+            node = next;
+        }
+    }
+    free(old);
+}
+
+/* Links a free block of the given order into its list and the hash */
+static void link_free(buddy_t *b, block_t *blk, int order) {
+    bnode_t *node = (bnode_t*) malloc(sizeof(bnode_t));
+    if (node == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in buddy link_free\n");
+        exit(1);
+    }
+    node->blk = blk;
+    node->order = order;
+    node->next = NULL;
+    node->prev = b->tail[order];
+    if (node->prev) node->prev->next = node;
+    else b->head[order] = node;
+    b->tail[order] = node;
+    b->nonempty |= 1u << order;
+
+    if (b->count >= b->nbuckets)
+        rehash(b);
+    unsigned int h = bucket(b, blk->start);
+    node->hnext = b->table[h];
+    b->table[h] = node;
+    b->count++;
+}
+
+/* Unlinks node from its list and the hash, frees it and returns its block */
+static block_t *unlink_free(buddy_t *b, bnode_t *node) {
+    bnode_t **pp = &b->table[bucket(b, node->blk->start)];
+    block_t *blk = node->blk;
+    int k = node->order;
+
+    while (*pp != node)
+        pp = &(*pp)->hnext;
+    *pp = node->hnext;
+
+    if (node->prev) node->prev->next = node->next;
+    else b->head[k] = node->next;
+    if (node->next) node->next->prev = node->prev;
+    else b->tail[k] = node->prev;
+    if (b->head[k] == NULL)
+        b->nonempty &= ~(1u << k);
+
+    b->count--;
+    free(node);
+    return blk;
+}
+
+/* The free block of the given order at start, or NULL */
+static bnode_t *find_free(buddy_t *b, int start, int order) {
+    bnode_t *node;
+    for (node = b->table[bucket(b, start)]; node != NULL; node = node->hnext) {
+        if (node->blk->start == start)
+            return node->order == order ? node : NULL;
+    }
+    return NULL;
+}
+
+static block_t *new_block(int start, int order) {
+    block_t *blk = (block_t*) malloc(sizeof(block_t));
+    if (blk == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in buddy new_block\n");
+        exit(1);
+    }
+    blk->pid = 0;
+    blk->start = start;
+    blk->end = start + (1 << order) - 1;
+    return blk;
+}
+
+buddy_t *buddy_alloc(int size) {
+    buddy_t *b = (buddy_t*) xcalloc(1, sizeof(buddy_t), "buddy_alloc");
+    int start = 0;
+
+    b->nbuckets = 64;
+    b->table = (bnode_t**) xcalloc(b->nbuckets, sizeof(bnode_t*), "buddy_alloc");
+
+    /* largest aligned power-of-two pieces, left to right */
+    while (start < size) {
+        int k = start > 0 ? __builtin_ctz((unsigned int)start) : BUDDY_ORDERS - 1;
+        while ((1 << k) > size - start)
+            k--;
+        link_free(b, new_block(start, k), k);
+        start += 1 << k;
+    }
+    return b;
+}
+
+void buddy_free(buddy_t *b) {
+    if (b == NULL) return;
+    for (int k = 0; k < BUDDY_ORDERS; k++) {
+        while (b->head[k] != NULL)
+            free(unlink_free(b, b->head[k]));
+    }
+    free(b->table);
+    free(b);
+}
+
+block_t *buddy_take(buddy_t *b, int size) {
+    int k, j;
+    unsigned int larger;
+    block_t *blk;
+
+    if (size > 1 << (BUDDY_ORDERS - 1))
+        return NULL;
+    k = order_of(size);
+    larger = b->nonempty >> k << k;
+    if (larger == 0)
+        return NULL;
+
+    /* split the smallest free block that is large enough down to order k,
+       returning the upper halves */
+    j = __builtin_ctz(larger);
+    blk = unlink_free(b, b->head[j]);
+    while (j > k) {
+        j--;
+        link_free(b, new_block(blk->start + (1 << j), j), j);
+        blk->end = blk->start + (1 << j) - 1;
+    }
+    return blk;
+}
+
+void buddy_put(buddy_t *b, block_t *blk) {
+    int k = order_of(blk->end - blk->start + 1);
+    bnode_t *buddy;
+
+    blk->pid = 0;
+    while (k < BUDDY_ORDERS - 1 &&
+           (buddy = find_free(b, blk->start ^ (1 << k), k)) != NULL) {
+        block_t *other = unlink_free(b, buddy);
+        if (other->start < blk->start)
+            blk->start = other->start;
+        free(other);
+        k++;
+        blk->end = blk->start + (1 << k) - 1;
+    }
+    link_free(b, blk, k);
+}
+
+void buddy_walk(buddy_t *b, void (*visit)(block_t *, void *), void *arg) {
+    if (b == NULL) return;
+    for (int k = 0; k < BUDDY_ORDERS; k++) {
+        for (bnode_t *node = b->head[k]; node != NULL; node = node->next)
+            visit(node->blk, arg);
+    }
+}
@@ -0,0 +1,61 @@
+// MMU/buddy.h
+//
+// Binary buddy allocator for the MMU. Memory is handed out in blocks of
+// 2^k units aligned to their size, so the buddy of the block at start is
+// at start ^ 2^k. Each order keeps a doubly linked free list, and a hash
+// on start address finds a free buddy in O(1). An allocation splits one
+// larger block down to the order it needs, and a free merges with free
+// buddies on the way back up. Both take O(log N) steps, and a separate
+// coalescing pass is never needed.
+//
+// A partition that is not a power of two is cut from address 0 into the
+// largest aligned power-of-two blocks that fit. Those blocks never merge
+// with each other, because their buddies lie past the end.
+//
+// <Author>
+
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include "list.h"
+
+/* Orders 0..30 cover every positive int size. */
+#define BUDDY_ORDERS 31
+
+struct buddy_node {
+	block_t *blk;
+	int order;
+	struct buddy_node *prev, *next;   /* free list of its order */
+	struct buddy_node *hnext;         /* hash chain */
+};
+
+struct buddy {
+	struct buddy_node *head[BUDDY_ORDERS];   /* oldest first */
+	struct buddy_node *tail[BUDDY_ORDERS];
+	unsigned int nonempty;                   /* bit k: head[k] != NULL */
+	struct buddy_node **table;               /* free blocks by start */
+	int nbuckets;                            /* a power of two */
+	int count;
+};
+typedef struct buddy buddy_t;
+
+/* An allocator over the addresses [0, size). */
+buddy_t *buddy_alloc(int size);
+
+/* Frees the allocator and every free block it holds. */
+void buddy_free(buddy_t *b);
+
+/* Size of the block buddy_take hands out for a request of size. */
+int buddy_block_size(int size);
+
+/* Removes and returns a free block of buddy_block_size(size) units, split
+ * off a larger one if needed, or NULL if no block is large enough. */
+block_t *buddy_take(buddy_t *b, int size);
+
+/* Returns a block from buddy_take, merging it with its free buddies. */
+void buddy_put(buddy_t *b, block_t *blk);
+
+/* Calls visit on every free block, smallest order first. */
+void buddy_walk(buddy_t *b, void (*visit)(block_t *, void *), void *arg);
+
+#endif // BUDDY_H
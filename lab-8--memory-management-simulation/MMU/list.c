@@ -1,19 +1,41 @@
 // list/list.c
 // Polished linked-list implementation for MMU assignment
 // Updated: stable descending tie-handling and robust list ops.
+// The linking itself is generated by glist.h; this file supplies the block
+// specific orderings and searches as inlined match/order expressions.
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "list.h"
 
+#define BLK_SIZE(b) (((b)->end - (b)->start) + 1)
+
+/* Orderings: insert e before the first node x for which these hold. */
+#define BY_ADDRESS(e, x)   ((x)->blk->start >= (e)->blk->start)
+#define BY_SIZE_ASC(e, x)  (BLK_SIZE((e)->blk) < BLK_SIZE((x)->blk))
+/* ties go AFTER existing nodes of equal size */
+#define BY_SIZE_DESC(e, x) (BLK_SIZE((e)->blk) >= BLK_SIZE((x)->blk))
+
+/* Searches: first node whose block matches the key. */
+#define FITS_SIZE(n, k) ((k) <= BLK_SIZE((n)->blk))
+#define HAS_PID(n, k)   ((n)->blk->pid == (k))
+#define SAME_BLK(n, k)  compareBlks((k), (n)->blk)
+
+GLIST_DEFINE_INSERT_SORTED(blist, insert_by_address, node_t, next, BY_ADDRESS)
+GLIST_DEFINE_INSERT_SORTED(blist, insert_by_size_asc, node_t, next, BY_SIZE_ASC)
+GLIST_DEFINE_INSERT_SORTED(blist, insert_by_size_desc, node_t, next, BY_SIZE_DESC)
+GLIST_DEFINE_FIND(blist, find_size, node_t, next, int, FITS_SIZE)
+GLIST_DEFINE_FIND(blist, find_pid, node_t, next, int, HAS_PID)
+GLIST_DEFINE_FIND(blist, find_blk, node_t, next, block_t *, SAME_BLK)
+
 list_t *list_alloc() {
     list_t *list = (list_t*) malloc(sizeof(list_t));
     if (list == NULL) {
         fprintf(stderr, "Fatal: malloc failed in list_alloc\n");
         exit(1);
     }
-    list->head = NULL;
+    blist_init(list);
     return list;
 }
 
@@ -32,12 +54,10 @@ node_t *node_alloc(block_t *blk) {
  * Use carefully: only call when blocks are not used elsewhere. */
 void list_free(list_t *l) {
     if (l == NULL) return;
-    node_t *cur = l->head;
-    while (cur != NULL) {
-        node_t *next = cur->next;
+    node_t *cur;
+    while ((cur = blist_pop_front(l)) != NULL) {
         if (cur->blk) free(cur->blk);
         free(cur);
-        cur = next;
     }
     free(l);
 }
@@ -46,45 +66,39 @@ void node_free(node_t *node) {
     if (node) free(node);
 }
 
+/* Unlinks the node after prev (the head when prev is NULL) and returns its
+ * block, freeing the node itself. */
+static block_t *take_after(list_t *l, node_t *prev) {
+    node_t *node = blist_remove_after(l, prev);
+    if (node == NULL) return NULL;
+    block_t *blk = node->blk;
+    free(node);
+    return blk;
+}
+
 void list_print(list_t *l) {
-    node_t *current = (l == NULL) ? NULL : l->head;
+    node_t *current;
     block_t *b;
-    if (current == NULL) {
+    if (l == NULL || l->head == NULL) {
         printf("list is empty\n");
         return;
     }
-    while (current != NULL) {
+    GLIST_FOREACH(current, l, next) {
         b = current->blk;
         printf("PID=%d START:%d END:%d\n", b->pid, b->start, b->end);
-        current = current->next;
     }
 }
 
 int list_length(list_t *l) {
-    node_t *current = (l == NULL) ? NULL : l->head;
-    int i = 0;
-    while (current != NULL) {
-        i++;
-        current = current->next;
-    }
-    return i;
+    return (l == NULL) ? 0 : l->length;
 }
 
 void list_add_to_back(list_t *l, block_t *blk) {
-    node_t *newNode = node_alloc(blk);
-    if (l->head == NULL) {
-        l->head = newNode;
-        return;
-    }
-    node_t *cur = l->head;
-    while (cur->next != NULL) cur = cur->next;
-    cur->next = newNode;
+    blist_push_back(l, node_alloc(blk));
 }
 
 void list_add_to_front(list_t *l, block_t *blk) {
-    node_t *newNode = node_alloc(blk);
-    newNode->next = l->head;
-    l->head = newNode;
+    blist_push_front(l, node_alloc(blk));
 }
 
 void list_add_at_index(list_t *l, block_t *blk, int index) {
@@ -93,74 +107,22 @@ void list_add_at_index(list_t *l, block_t *blk, int index) {
         list_add_to_front(l, blk);
         return;
     }
-
-    node_t *newNode = node_alloc(blk);
-    node_t *cur = l->head;
-    int i = 0;
-
-    while (cur->next != NULL && i < index - 1) {
-        cur = cur->next;
-        i++;
-    }
-    newNode->next = cur->next;
-    cur->next = newNode;
+    /* past the end appends, as before */
+    node_t *prev = (index - 1 < l->length) ? blist_at(l, index - 1, NULL) : l->tail;
+    blist_insert_after(l, prev, node_alloc(blk));
 }
 
 /* Insert in ascending order by start address */
 void list_add_ascending_by_address(list_t *l, block_t *newblk) {
     if (l == NULL) return;
-    node_t *newNode = node_alloc(newblk);
-    if (l->head == NULL) {
-        l->head = newNode;
-        return;
-    }
-
-    node_t *cur = l->head;
-    node_t *prev = NULL;
-
-    while (cur != NULL && cur->blk->start < newblk->start) {
-        prev = cur;
-        cur = cur->next;
-    }
-
-    if (prev == NULL) {
-        newNode->next = l->head;
-        l->head = newNode;
-    } else {
-        prev->next = newNode;
-        newNode->next = cur;
-    }
+    blist_insert_by_address(l, node_alloc(newblk));
 }
 
 /* Insert in ascending order by blocksize (small -> large).
  * blocksize = end - start + 1 */
 void list_add_ascending_by_blocksize(list_t *l, block_t *newblk) {
     if (l == NULL) return;
-    int new_size = (newblk->end - newblk->start) + 1;
-    node_t *newNode = node_alloc(newblk);
-
-    if (l->head == NULL) {
-        l->head = newNode;
-        return;
-    }
-
-    node_t *cur = l->head;
-    node_t *prev = NULL;
-
-    while (cur != NULL) {
-        int cur_size = (cur->blk->end - cur->blk->start) + 1;
-        if (new_size < cur_size) break;
-        prev = cur;
-        cur = cur->next;
-    }
-
-    if (prev == NULL) {
-        newNode->next = l->head;
-        l->head = newNode;
-    } else {
-        prev->next = newNode;
-        newNode->next = cur;
-    }
+    blist_insert_by_size_asc(l, node_alloc(newblk));
 }
 
 /* Insert in descending order by blocksize (large -> small).
@@ -168,32 +130,7 @@ void list_add_ascending_by_blocksize(list_t *l, block_t *newblk) {
  * Tie-handling: place new block **after** existing blocks of same size (stable) */
 void list_add_descending_by_blocksize(list_t *l, block_t *blk) {
     if (l == NULL) return;
-    int new_size = (blk->end - blk->start) + 1;
-    node_t *newNode = node_alloc(blk);
-
-    if (l->head == NULL) {
-        l->head = newNode;
-        return;
-    }
-
-    node_t *cur = l->head;
-    node_t *prev = NULL;
-
-    while (cur != NULL) {
-        int cur_size = (cur->blk->end - cur->blk->start) + 1;
-        /* break if new_size >= cur_size so ties go AFTER existing nodes of equal size */
-        if (new_size >= cur_size) break;
-        prev = cur;
-        cur = cur->next;
-    }
-
-    if (prev == NULL) {
-        newNode->next = l->head;
-        l->head = newNode;
-    } else {
-        prev->next = newNode;
-        newNode->next = cur;
-    }
+    blist_insert_by_size_desc(l, node_alloc(blk));
 }
 
 /* Merge physically adjacent nodes in ascending-by-address order */
@@ -201,19 +138,13 @@ void list_coalese_nodes(list_t *l) {
     if (l == NULL || l->head == NULL) return;
 
     node_t *prev = l->head;
-    node_t *cur = prev->next;
-
-    while (cur != NULL) {
-        if (prev->blk->end + 1 == cur->blk->start) {
-            prev->blk->end = cur->blk->end;
-            node_t *to_free = cur;
-            cur = cur->next;
-            prev->next = cur;
-            if (to_free->blk) free(to_free->blk);
-            node_free(to_free);
+    while (prev->next != NULL) {
+        block_t *next = prev->next->blk;
+        if (prev->blk->end + 1 == next->start) {
+            prev->blk->end = next->end;
+            free(take_after(l, prev));
         } else {
-            prev = cur;
-            cur = cur->next;
+            prev = prev->next;
         }
     }
 }
@@ -221,65 +152,22 @@ void list_coalese_nodes(list_t *l) {
 /* remove last node, return its block pointer (caller frees block when appropriate) */
 block_t* list_remove_from_back(list_t *l) {
     if (l == NULL || l->head == NULL) return NULL;
-
-    node_t *cur = l->head;
-    node_t *prev = NULL;
-
-    /* only one node */
-    if (cur->next == NULL) {
-        block_t *blk = cur->blk;
-        free(cur);
-        l->head = NULL;
-        return blk;
-    }
-
-    /* move to penultimate node */
-    while (cur->next != NULL) {
-        prev = cur;
-        cur = cur->next;
-    }
-
-    /* cur is last, prev is penultimate */
-    block_t *blk = cur->blk;
-    free(cur);
-    prev->next = NULL;
-    return blk;
-}
-
-block_t* list_get_from_front(list_t *l) {
-    if (l == NULL || l->head == NULL) return NULL;
-    return l->head->blk;
+    node_t *prev = (l->length > 1) ? blist_at(l, l->length - 2, NULL) : NULL;
+    return take_after(l, prev);
 }
 
 block_t* list_remove_from_front(list_t *l) {
-    if (l == NULL || l->head == NULL) return NULL;
-    node_t *cur = l->head;
-    block_t *blk = cur->blk;
-    l->head = cur->next;
-    free(cur);
-    return blk;
+    if (l == NULL) return NULL;
+    return take_after(l, NULL);
 }
 
 block_t* list_remove_at_index(list_t *l, int index) {
     if (l == NULL || l->head == NULL) return NULL;
     if (index <= 0) return list_remove_from_front(l);
 
-    node_t *cur = l->head;
-    node_t *prev = NULL;
-    int i = 0;
-
-    while (cur != NULL && i < index) {
-        prev = cur;
-        cur = cur->next;
-        i++;
-    }
-
-    if (cur == NULL) return NULL;
-
-    prev->next = cur->next;
-    block_t *blk = cur->blk;
-    free(cur);
-    return blk;
+    node_t *prev;
+    if (blist_at(l, index, &prev) == NULL) return NULL;
+    return take_after(l, prev);
 }
 
 bool compareBlks(block_t* a, block_t *b) {
@@ -287,92 +175,46 @@ bool compareBlks(block_t* a, block_t *b) {
     return (a->pid == b->pid && a->start == b->start && a->end == b->end);
 }
 
-bool compareSize(int a, block_t *b) {
-    if (b == NULL) return false;
-    return (a <= (b->end - b->start) + 1);
-}
-
-bool comparePid(int a, block_t *b) {
-    if (b == NULL) return false;
-    return (a == b->pid);
-}
-
 bool list_is_in(list_t *l, block_t* value) {
     if (l == NULL) return false;
-    node_t *cur = l->head;
-    while (cur != NULL) {
-        if (compareBlks(value, cur->blk)) return true;
-        cur = cur->next;
-    }
-    return false;
+    return blist_find_blk(l, value, NULL, NULL) != NULL;
 }
 
 block_t* list_get_elem_at(list_t *l, int index) {
-    if (l == NULL || l->head == NULL) return NULL;
-    node_t *cur = l->head;
-    int i = 0;
-    while (cur != NULL) {
-        if (i == index) return cur->blk;
-        cur = cur->next;
-        i++;
-    }
-    return NULL;
+    if (l == NULL) return NULL;
+    node_t *node = blist_at(l, index, NULL);
+    return node ? node->blk : NULL;
 }
 
 int list_get_index_of(list_t *l, block_t* value) {
-    if (l == NULL || l->head == NULL) return -1;
-    node_t *cur = l->head;
-    int i = 0;
-    while (cur != NULL) {
-        if (compareBlks(value, cur->blk)) return i;
-        cur = cur->next;
-        i++;
-    }
-    return -1;
+    int i;
+    if (l == NULL) return -1;
+    blist_find_blk(l, value, NULL, &i);
+    return i;
 }
 
 bool list_is_in_by_size(list_t *l, int Size) {
     if (l == NULL) return false;
-    node_t *cur = l->head;
-    while (cur != NULL) {
-        if (compareSize(Size, cur->blk)) return true;
-        cur = cur->next;
-    }
-    return false;
+    return blist_find_size(l, Size, NULL, NULL) != NULL;
 }
 
 bool list_is_in_by_pid(list_t *l, int pid) {
     if (l == NULL) return false;
-    node_t *cur = l->head;
-    while (cur != NULL) {
-        if (comparePid(pid, cur->blk)) return true;
-        cur = cur->next;
-    }
-    return false;
+    return blist_find_pid(l, pid, NULL, NULL) != NULL;
 }
 
 int list_get_index_of_by_Size(list_t *l, int Size) {
-    if (l == NULL || l->head == NULL) return -1;
-    node_t *cur = l->head;
-    int i = 0;
-    while (cur != NULL) {
-        if (compareSize(Size, cur->blk)) return i;
-        cur = cur->next;
-        i++;
-    }
-    return -1;
+    int i;
+    if (l == NULL) return -1;
+    blist_find_size(l, Size, NULL, &i);
+    return i;
 }
 
 int list_get_index_of_by_Pid(list_t *l, int pid) {
-    if (l == NULL || l->head == NULL) return -1;
-    node_t *cur = l->head;
-    int i = 0;
-    while (cur != NULL) {
-        if (comparePid(pid, cur->blk)) return i;
-        cur = cur->next;
-        i++;
-    }
-    return -1;
+    int i;
+    if (l == NULL) return -1;
+    blist_find_pid(l, pid, NULL, &i);
+    return i;
 }
 
 /* Return element in front or NULL if empty */
@@ -4,7 +4,11 @@
 //
 // <Author>
 
+#ifndef LIST_H
+#define LIST_H
+
 #include <stdbool.h>
+#include "glist.h"
 
 typedef struct block {
     int pid;   // pid
@@ -20,12 +24,10 @@ typedef struct node {
 	struct node *next;
 }node_t;
 
-/* Defines the list structure, which simply points to the first node in the
- * list. */
-struct list {
-	node_t *head;
-};
-typedef struct list list_t;
+/* The list itself (head, tail and length) and its linking operations are
+ * generated by the shared glist.h from lab-1. */
+GLIST_DEFINE(blist, node_t, next)
+typedef struct blist list_t;
 
 /* Functions for allocating and freeing lists. By using only these functions,
  * the user should be able to allocate and free all the memory required for
@@ -83,3 +85,5 @@ bool compareBlks(block_t* a, block_t *b);
 
 /* join adjacent nodes who blocks are physically next to each other */
 void list_coalese_nodes(list_t *l);
+
+#endif // LIST_H
@@ -2,26 +2,49 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
+#include <time.h>
 #include "list.h"
+#include "segfit.h"
+#include "blktree.h"
+#include "buddy.h"
 #include "util.h"
 
+#define USAGE "usage: ./mmu <input file> -{F | B | W | S | Y}  \n(F=FIFO | B=BESTFIT | W-WORSTFIT | S=SEGFIT | Y=BUDDY)\n"
+
+/* The free memory of one run. FIFO keeps a list; best-fit and worst-fit a
+ * balanced tree in the same order as their sorted list, so a fit takes
+ * O(log n); segregated fit keeps its size-class bins and the buddy system
+ * its per-order lists. The counters feed the summary printed at the end. */
+typedef struct free_store {
+    int policy;
+    list_t *list;     /* policy 1 */
+    blktree_t *tree;  /* policies 2-3 */
+    segfit_t *bins;   /* policy 4 */
+    buddy_t *buddy;   /* policy 5 */
+    int requests;     /* allocation requests */
+    int failures;     /* requests no free block could hold */
+    int frees;        /* successful deallocations */
+    long long requested;   /* units asked for by successful allocations */
+    long long granted;     /* units they were given */
+    long long alloc_ns;    /* time spent in the free store per operation */
+    long long free_ns;
+} free_store_t;
+
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
 void TOUPPER(char * arr){
     for(int i = 0; arr[i] != '\0'; i++){
         arr[i] = toupper(arr[i]);
     }
 }
 
-void get_input(char *args[], int input[][2], int *n, int *size, int *policy)
+void get_input(char *args[], int (**input)[2], int *n, int *size, int *policy)
 {
-    FILE *input_file = fopen(args[1], "r");
-    if (!input_file) {
-        fprintf(stderr, "Error: Invalid filepath\n");
-        fflush(stdout);
-        exit(0);
-    }
-
-    parse_file(input_file, input, n, size);
-    fclose(input_file);
+    parse_file(args[1], input, n, size);
 
     TOUPPER(args[2]);
 
@@ -31,36 +54,126 @@ void get_input(char *args[], int input[][2], int *n, int *size, int *policy)
         *policy = 2;
     else if ((strcmp(args[2], "-W") == 0) || (strcmp(args[2], "-WORSTFIT") == 0))
         *policy = 3;
+    else if ((strcmp(args[2], "-S") == 0) || (strcmp(args[2], "-SEGFIT") == 0))
+        *policy = 4;
+    else if ((strcmp(args[2], "-Y") == 0) || (strcmp(args[2], "-BUDDY") == 0))
+        *policy = 5;
     else {
-        printf("usage: ./mmu <input file> -{F | B | W }  \n(F=FIFO | B=BESTFIT | W-WORSTFIT)\n");
+        printf(USAGE);
         exit(1);
     }
 }
 
-/* Allocate memory according to policy:
- * policy: 1 FIFO (first-fit -> freelist in FIFO)
- *         2 Best-fit (freelist sorted ascending by blocksize)
- *         3 Worst-fit (freelist sorted descending by blocksize)
- */
-void allocate_memory(list_t * freelist, list_t * alloclist, int pid, int blocksize, int policy) {
-    if (freelist == NULL || alloclist == NULL) return;
+/* Returns a free block to the store according to its policy */
+void free_put(free_store_t *fs, block_t *blk) {
+    if (fs->policy == 1) {
+        list_add_to_back(fs->list, blk);
+    } else if (fs->policy == 2) {
+        blktree_add_ascending_by_blocksize(fs->tree, blk);
+    } else if (fs->policy == 3) {
+        blktree_add_descending_by_blocksize(fs->tree, blk);
+    } else if (fs->policy == 4) {
+        segfit_add(fs->bins, blk);
+    } else {
+        buddy_put(fs->buddy, blk);
+    }
+}
+
+/* Removes the free block the policy picks for a request of blocksize, or
+ * returns NULL if none is large enough */
+block_t *free_take(free_store_t *fs, int blocksize) {
+    if (fs->policy == 4)
+        return segfit_take(fs->bins, blocksize);
+    if (fs->policy == 5)
+        return buddy_take(fs->buddy, blocksize);
+
+    /* the first block of at least blocksize in policy order: the smallest
+       such block for best-fit, the largest block for worst-fit */
+    if (fs->policy != 1)
+        return blktree_remove_first_by_size(fs->tree, blocksize);
 
     /* Check if any free block can satisfy the request */
-    if (!list_is_in_by_size(freelist, blocksize)) {
-        printf("Error: Not Enough Memory\n");
-        return;
+    if (!list_is_in_by_size(fs->list, blocksize))
+        return NULL;
+
+    /* pick the first block in the freelist (the freelist is kept in FIFO order) */
+    int idx = list_get_index_of_by_Size(fs->list, blocksize);
+    if (idx < 0)
+        return NULL;
+    return list_remove_at_index(fs->list, idx);
+}
+
+/* Calls visit on every free block, in print order */
+void free_walk(free_store_t *fs, void (*visit)(block_t *, void *), void *arg) {
+    node_t *current;
+
+    if (fs->policy == 2 || fs->policy == 3) {
+        blktree_walk(fs->tree, visit, arg);
+    } else if (fs->policy == 4) {
+        for (int k = 0; k < SEGFIT_BINS; k++)
+            GLIST_FOREACH(current, &fs->bins->bin[k], next)
+                visit(current->blk, arg);
+    } else if (fs->policy == 5) {
+        buddy_walk(fs->buddy, visit, arg);
+    } else {
+        GLIST_FOREACH(current, fs->list, next)
+            visit(current->blk, arg);
     }
+}
 
-    /* pick the first block in the freelist (the freelist is expected to be kept in
-       correct order for Best/Worst/FIFO semantics) */
-    int idx = list_get_index_of_by_Size(freelist, blocksize);
-    if (idx < 0) {
-        printf("Error: Not Enough Memory\n");
+/* Sets up an empty store for policy over a partition of size units and
+ * adds the partition as its one free block */
+void free_store_init(free_store_t *fs, int policy, int size) {
+    *fs = (free_store_t) { 0 };
+    fs->policy = policy;
+    if (policy == 1) {
+        fs->list = list_alloc();
+    } else if (policy == 4) {
+        fs->bins = segfit_alloc();
+    } else if (policy == 5) {
+        fs->buddy = buddy_alloc(size);   /* cuts its own initial blocks */
         return;
+    } else {
+        fs->tree = blktree_alloc();
     }
 
-    block_t *blk = list_remove_at_index(freelist, idx);
+    /* create initial partition and add to free list */
+    block_t * partition = (block_t*) malloc(sizeof(block_t));
+    if (partition == NULL) {
+        fprintf(stderr, "Fatal: malloc failed for initial partition\n");
+        exit(1);
+    }
+    partition->start = 0;
+    partition->end = size + partition->start - 1;
+    partition->pid = 0;
+
+    free_put(fs, partition);
+}
+
+/* Frees the store and every block still in it */
+void free_store_release(free_store_t *fs) {
+    list_free(fs->list);
+    blktree_free(fs->tree);
+    segfit_free(fs->bins);
+    buddy_free(fs->buddy);
+}
+
+/* Allocate memory according to policy:
+ * policy: 1 FIFO (first-fit -> freelist in FIFO)
+ *         2 Best-fit (freelist sorted ascending by blocksize)
+ *         3 Worst-fit (freelist sorted descending by blocksize)
+ *         4 Segregated fit (power-of-two size-class bins)
+ *         5 Buddy system (whole power-of-two blocks, never trimmed)
+ */
+void allocate_memory(free_store_t * fs, list_t * alloclist, int pid, int blocksize) {
+    if (fs == NULL || alloclist == NULL) return;
+
+    long long t0 = now_ns();
+    fs->requests++;
+    block_t *blk = free_take(fs, blocksize);
     if (blk == NULL) {
+        fs->alloc_ns += now_ns() - t0;
+        fs->failures++;
         printf("Error: Not Enough Memory\n");
         return;
     }
@@ -70,10 +183,10 @@ void allocate_memory(list_t * freelist, list_t * alloclist, int pid, int blocksi
 
     /* allocate portion to process */
     blk->pid = pid;
-    blk->end = blk->start + blocksize - 1;
-
-    /* add to allocated list sorted by address */
-    list_add_ascending_by_address(alloclist, blk);
+    if (fs->policy != 5)
+        blk->end = blk->start + blocksize - 1;
+    fs->requested += blocksize;
+    fs->granted += blk->end - blk->start + 1;
 
     /* create fragment if leftover */
     if (blk->end < original_end) {
@@ -87,18 +200,16 @@ void allocate_memory(list_t * freelist, list_t * alloclist, int pid, int blocksi
         fragment->end = original_end;
 
         /* insert fragment back to free list according to policy */
-        if (policy == 1) {
-            list_add_to_back(freelist, fragment);
-        } else if (policy == 2) {
-            list_add_ascending_by_blocksize(freelist, fragment);
-        } else {
-            list_add_descending_by_blocksize(freelist, fragment);
-        }
+        free_put(fs, fragment);
     }
+    fs->alloc_ns += now_ns() - t0;
+
+    /* add to allocated list sorted by address */
+    list_add_ascending_by_address(alloclist, blk);
 }
 
-void deallocate_memory(list_t * alloclist, list_t * freelist, int pid, int policy) {
-    if (alloclist == NULL || freelist == NULL) return;
+void deallocate_memory(list_t * alloclist, free_store_t * fs, int pid) {
+    if (alloclist == NULL || fs == NULL) return;
 
     if (!list_is_in_by_pid(alloclist, pid)) {
         printf("Error: Can't locate Memory Used by PID: %d\n", pid);
@@ -120,13 +231,10 @@ void deallocate_memory(list_t * alloclist, list_t * freelist, int pid, int polic
     blk->pid = 0;
 
     /* insert back into freelist according to policy */
-    if (policy == 1) {
-        list_add_to_back(freelist, blk);
-    } else if (policy == 2) {
-        list_add_ascending_by_blocksize(freelist, blk);
-    } else {
-        list_add_descending_by_blocksize(freelist, blk);
-    }
+    long long t0 = now_ns();
+    free_put(fs, blk);
+    fs->free_ns += now_ns() - t0;
+    fs->frees++;
 }
 
 /* Coalesce the free list:
@@ -155,73 +263,121 @@ list_t* coalese_memory(list_t * list) {
     return temp_list;
 }
 
+/* The buddy system merges on every free, and blocks that are adjacent but
+ * not buddies must stay apart, so it has nothing to coalesce */
+void free_coalesce(free_store_t *fs) {
+    if (fs->policy == 2 || fs->policy == 3)
+        blktree_coalesce(fs->tree);
+    else if (fs->policy == 4)
+        segfit_coalesce(fs->bins);
+    else if (fs->policy == 1)
+        fs->list = coalese_memory(fs->list);
+}
+
+/* Prints blk as the next numbered block; arg counts them */
+void print_block(block_t * blk, void * arg){
+    int *i = (int *)arg;
+    printf("Block %d:\t START: %d\t END: %d\t PID: %d\n", *i, blk->start, blk->end, blk->pid);
+    *i += 1;
+}
+
 void print_list(list_t * list, char * message){
-    node_t *current = (list == NULL) ? NULL : list->head;
-    block_t *blk;
+    node_t *current;
     int i = 0;
 
     printf("%s:\n", message);
+    if (list == NULL) return;
+    GLIST_FOREACH(current, list, next)
+        print_block(current->blk, &i);
+}
 
-    while(current != NULL){
-        blk = current->blk;
-        printf("Block %d:\t START: %d\t END: %d\t PID: %d\n", i, blk->start, blk->end, blk->pid);
-        current = current->next;
-        i += 1;
-    }
+void print_free(free_store_t * fs, char * message){
+    int i = 0;
+
+    printf("%s:\n", message);
+    free_walk(fs, print_block, &i);
+}
+
+typedef struct free_tally {
+    int blocks;
+    int largest;
+    long long total;
+} free_tally_t;
+
+void tally_block(block_t * blk, void * arg){
+    free_tally_t *t = (free_tally_t *)arg;
+    int size = blk->end - blk->start + 1;
+    t->blocks++;
+    t->total += size;
+    if (size > t->largest)
+        t->largest = size;
+}
+
+/* Failure count, external fragmentation (the share of free memory outside
+ * the largest free block), internal fragmentation (the share of the memory
+ * granted over all allocations that was not asked for) and the average time
+ * the free store took per operation, on stderr so stdout stays the trace */
+void print_summary(free_store_t * fs){
+    free_tally_t t = { 0, 0, 0 };
+
+    free_walk(fs, tally_block, &t);
+    fprintf(stderr, "Allocation requests = %d, failures = %d\n", fs->requests, fs->failures);
+    fprintf(stderr, "Free blocks = %d, free memory = %lld, largest free block = %d\n",
+            t.blocks, t.total, t.largest);
+    fprintf(stderr, "External fragmentation = %.2f%%\n",
+            t.total > 0 ? 100.0 * (1.0 - (double)t.largest / t.total) : 0.0);
+    fprintf(stderr, "Internal fragmentation = %.2f%% (%lld granted for %lld requested)\n",
+            fs->granted > 0 ? 100.0 * (fs->granted - fs->requested) / fs->granted : 0.0,
+            fs->granted, fs->requested);
+    fprintf(stderr, "Average time per allocate = %.0f ns, per deallocate = %.0f ns\n",
+            fs->requests > 0 ? (double)fs->alloc_ns / fs->requests : 0.0,
+            fs->frees > 0 ? (double)fs->free_ns / fs->frees : 0.0);
 }
 
 /* DO NOT MODIFY - main orchestrates simulation */
 int main(int argc, char *argv[])
 {
-    int PARTITION_SIZE, inputdata[200][2], N = 0, Memory_Mgt_Policy;
+    int PARTITION_SIZE, (*inputdata)[2] = NULL, N = 0, Memory_Mgt_Policy;
 
-    list_t *FREE_LIST = list_alloc();   /* free blocks (pid == 0) */
+    free_store_t FREE_LIST;             /* free blocks (pid == 0) */
     list_t *ALLOC_LIST = list_alloc();  /* allocated blocks (pid != 0) */
     int i;
 
     if(argc != 3) {
-        printf("usage: ./mmu <input file> -{F | B | W }  \n(F=FIFO | B=BESTFIT | W-WORSTFIT)\n");
+        printf(USAGE);
         exit(1);
     }
 
-    get_input(argv, inputdata, &N, &PARTITION_SIZE, &Memory_Mgt_Policy);
-
-    /* create initial partition and add to free list */
-    block_t * partition = (block_t*) malloc(sizeof(block_t));
-    if (partition == NULL) {
-        fprintf(stderr, "Fatal: malloc failed for initial partition\n");
-        exit(1);
-    }
-    partition->start = 0;
-    partition->end = PARTITION_SIZE + partition->start - 1;
-    partition->pid = 0;
-
-    list_add_to_front(FREE_LIST, partition);
+    get_input(argv, &inputdata, &N, &PARTITION_SIZE, &Memory_Mgt_Policy);
+    free_store_init(&FREE_LIST, Memory_Mgt_Policy, PARTITION_SIZE);
 
     for(i = 0; i < N; i++) {
         printf("************************\n");
         if(inputdata[i][0] != -99999 && inputdata[i][0] > 0) {
             printf("ALLOCATE: %d FROM PID: %d\n", inputdata[i][1], inputdata[i][0]);
-            allocate_memory(FREE_LIST, ALLOC_LIST, inputdata[i][0], inputdata[i][1], Memory_Mgt_Policy);
+            allocate_memory(&FREE_LIST, ALLOC_LIST, inputdata[i][0], inputdata[i][1]);
         }
         else if (inputdata[i][0] != -99999 && inputdata[i][0] < 0) {
             printf("DEALLOCATE MEM: PID %d\n", abs(inputdata[i][0]));
-            deallocate_memory(ALLOC_LIST, FREE_LIST, abs(inputdata[i][0]), Memory_Mgt_Policy);
+            deallocate_memory(ALLOC_LIST, &FREE_LIST, abs(inputdata[i][0]));
         }
         else {
             printf("COALESCE/COMPACT\n");
-            FREE_LIST = coalese_memory(FREE_LIST);
+            free_coalesce(&FREE_LIST);
         }
 
         printf("************************\n");
-        print_list(FREE_LIST, "Free Memory");
+        print_free(&FREE_LIST, "Free Memory");
         print_list(ALLOC_LIST,"\nAllocated Memory");
         printf("\n\n");
     }
 
+    print_summary(&FREE_LIST);
+
     /* free both lists and their blocks */
-    list_free(FREE_LIST);
+    free_store_release(&FREE_LIST);
     list_free(ALLOC_LIST);
+    free(inputdata);
 
     return 0;
 }
@@ -0,0 +1,111 @@
+// MMU/segfit.c
+// Segregated-fit free lists: one FIFO bin per power-of-two size class.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "segfit.h"
+
+#define BLK_SIZE(b) (((b)->end - (b)->start) + 1)
+
+/* Size class of a block or request: floor(log2(size)), sizes below 1 in
+ * class 0. */
+static int size_class(int size) {
+    return size > 1 ? 31 - __builtin_clz((unsigned int)size) : 0;
+}
+
+segfit_t *segfit_alloc() {
+    segfit_t *sf = (segfit_t*) malloc(sizeof(segfit_t));
+    if (sf == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in segfit_alloc\n");
+        exit(1);
+    }
+    for (int k = 0; k < SEGFIT_BINS; k++)
+        blist_init(&sf->bin[k]);
+    sf->nonempty = 0;
+    sf->count = 0;
+    return sf;
+}
+
+void segfit_free(segfit_t *sf) {
+    if (sf == NULL) return;
+    for (int k = 0; k < SEGFIT_BINS; k++) {
+        node_t *cur;
+        while ((cur = blist_pop_front(&sf->bin[k])) != NULL) {
+            free(cur->blk);
+            free(cur);
+        }
+    }
+    free(sf);
+}
+
+void segfit_add(segfit_t *sf, block_t *blk) {
+    int k = size_class(BLK_SIZE(blk));
+    blist_push_back(&sf->bin[k], node_alloc(blk));
+    sf->nonempty |= 1u << k;
+    sf->count++;
+}
+
+/* Unlinks the node after prev in bin k and returns its block. */
+static block_t *take_from_bin(segfit_t *sf, int k, node_t *prev) {
+    node_t *node = blist_remove_after(&sf->bin[k], prev);
+    block_t *blk = node->blk;
+    free(node);
+    if (sf->bin[k].head == NULL)
+        sf->nonempty &= ~(1u << k);
+    sf->count--;
+    return blk;
+}
+
+block_t *segfit_take(segfit_t *sf, int size) {
+    int k = size_class(size);
+    node_t *prev = NULL, *cur;
+
+    /* blocks in the request's own class may still be too small */
+    GLIST_FOREACH(cur, &sf->bin[k], next) {
+        if (BLK_SIZE(cur->blk) >= size)
+            return take_from_bin(sf, k, prev);
+        prev = cur;
+    }
+
+    /* any block of a larger class fits */
+    unsigned int larger = k + 1 < SEGFIT_BINS ? sf->nonempty >> (k + 1) << (k + 1) : 0;
+    if (larger == 0)
+        return NULL;
+    return take_from_bin(sf, __builtin_ctz(larger), NULL);
+}
+
+static int by_address(const void *a, const void *b) {
+    const block_t *x = *(block_t * const *)a;
+    const block_t *y = *(block_t * const *)b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+void segfit_coalesce(segfit_t *sf) {
+    int n = sf->count, m = 0;
+    block_t **blks;
+
+    if (n == 0) return;
+    blks = (block_t**) malloc(n * sizeof(block_t*));
+    if (blks == NULL) {
+        fprintf(stderr, "Fatal: malloc failed in segfit_coalesce\n");
+        exit(1);
+    }
+    for (int k = 0; k < SEGFIT_BINS; k++) {
+        while (sf->bin[k].head != NULL)
+            blks[m++] = take_from_bin(sf, k, NULL);
+    }
+    qsort(blks, n, sizeof(block_t*), by_address);
+
+    block_t *run = blks[0];
+    for (int i = 1; i < n; i++) {
+        if (run->end + 1 == blks[i]->start) {
+            run->end = blks[i]->end;
+            free(blks[i]);
+        } else {
+            segfit_add(sf, run);
+            run = blks[i];
+        }
+    }
+    segfit_add(sf, run);
+    free(blks);
+}
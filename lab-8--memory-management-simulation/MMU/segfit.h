@@ -0,0 +1,43 @@
+// MMU/segfit.h
+//
+// Segregated free lists for the MMU: free blocks are binned by size class,
+// bin k holding the blocks of size [2^k, 2^(k+1)). A request of size s
+// first scans its own bin for a block of at least s, then takes the head of
+// the first non-empty larger bin, found from a bitmap of non-empty bins in
+// one step. Only the request's own bin is ever walked, so a fit is found in
+// near-constant time however many free blocks there are.
+//
+// <Author>
+
+#ifndef SEGFIT_H
+#define SEGFIT_H
+
+#include "list.h"
+
+/* One bin per bit of a positive int size. */
+#define SEGFIT_BINS 31
+
+struct segfit {
+	list_t bin[SEGFIT_BINS];   /* free blocks of each class, oldest first */
+	unsigned int nonempty;     /* bit k is set when bin[k] has a block */
+	int count;                 /* free blocks over all bins */
+};
+typedef struct segfit segfit_t;
+
+segfit_t *segfit_alloc();
+
+/* Frees the bins and every block still in them. */
+void segfit_free(segfit_t *sf);
+
+/* Adds a free block to the back of its bin. */
+void segfit_add(segfit_t *sf, block_t *blk);
+
+/* Removes and returns a free block of at least size, or NULL if none is
+ * large enough. */
+block_t *segfit_take(segfit_t *sf, int size);
+
+/* Merges physically adjacent free blocks and re-bins the result. The
+ * blocks are sorted by address once, so this is O(n log n). */
+void segfit_coalesce(segfit_t *sf);
+
+#endif // SEGFIT_H
@@ -2,35 +2,64 @@
 #include<stdio.h>
 #include<unistd.h>
 #include<stdlib.h>
+#include<limits.h>
 #include<errno.h>
 
 #include "util.h"
 #include "list.h"
+#include "tokenizer.h"
 
 /**
- * Returns an array of process that are parsed from
- * the input file descriptor passed as argument
+ * Parses the input file at path: the partition size, then one
+ * "pid size" request per line. The requests are returned through
+ * *input, an array that grows as needed, and their number in *n.
+ * The file is memory mapped and read in a single pass.
  * CAUTION: You need to free up the space that is allocated
  * by this function
  */
-void parse_file(FILE * f, int input[][2], int *n, int *PARTITION_SIZE)
+void parse_file(const char *path, int (**input)[2], int *n, int *PARTITION_SIZE)
 {
-  
-  // get the initial partition sizeof
-  
-  fscanf(f,"%d\n", PARTITION_SIZE);
+  Tokenizer tk;
+  int (*req)[2] = NULL;
+  size_t cap = 0, count = 0;
+  int v[2], k = 0;
+
+  if (tok_open(&tk, path) < 0) {
+    fprintf(stderr, "Error: Invalid filepath\n");
+    fflush(stdout);
+    exit(0);
+  }
+
+  // get the initial partition size
+  if (!tok_next_int(&tk, PARTITION_SIZE)) {
+    fprintf(stderr, "Error: %s: missing partition size\n", path);
+    exit(1);
+  }
   printf("PARTITION_SIZE = %d\n", *PARTITION_SIZE);
-  
-  while (!feof(f)) {
-		fscanf(f, "%d %d\n", &input[*n][0], &input[*n][1]);
-    /*
-    if(input[*n][0] != -99999 && input[*n][0] > 0)
-        printf("PID=%d ALLOCATE=%dbytes\n", input[*n][0], input[*n][1]);
-    else if (input[*n][0] != -99999 && input[*n][0] < 0)
-        printf("DEALLOCATED PROC = %d\n", abs(input[*n][0]));
-    else
-        printf("COALESCE\n");
-    */
-    *n += 1;
-	}
-}
\ No newline at end of file
+
+  tok_reserve((void **)&req, &cap, 1, sizeof(*req));
+  while (tok_next_int(&tk, &v[k])) {
+    if (++k < 2)
+      continue;
+    k = 0;
+    if (count == INT_MAX) {
+      fprintf(stderr, "Error: %s: too many requests\n", path);
+      exit(1);
+    }
+    tok_reserve((void **)&req, &cap, count + 1, sizeof(*req));
+    req[count][0] = v[0];
+    req[count][1] = v[1];
+    count++;
+  }
+  if (k != 0) {
+    fprintf(stderr, "Error: %s: incomplete request at end of file\n", path);
+    exit(1);
+  }
+
+  /* stderr carries the allocator summary; add parse timing only if asked */
+  if (getenv("PARSE_STATS"))
+    tok_report(&tk, path);
+  tok_close(&tk);
+  *input = req;
+  *n = (int)count;
+}
@@ -6,6 +6,6 @@
  */
 
 
-void parse_file(FILE *, int [][2], int *, int *);
+void parse_file(const char *, int (**)[2], int *, int *);
 
-#endif				// UTIL_H
\ No newline at end of file
+#endif				// UTIL_H
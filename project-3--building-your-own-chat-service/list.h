@@ -5,6 +5,11 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include "glist.h"
+
+/* All lists below are generated by the shared glist.h from lab-1: each
+   element carries its own next pointer and the list keeps head, tail and
+   length. */
 
 /* ----------------------------
    User list node (used elsewhere as struct node)
@@ -13,13 +18,15 @@ struct dm_node {
     int socket;               // socket of the DM peer
     struct dm_node *next;
 };
+GLIST_DEFINE(dm_list, struct dm_node, next)
 
 struct node {
    char username[30];
    int socket;
-   struct dm_node *dm;       // linked list of DM peers (by socket)
+   struct dm_list dm;        // DM peers (by socket)
    struct node *next;
 };
+GLIST_DEFINE(user_list, struct node, next)
 
 /* ----------------------------
    Room list and members
@@ -28,50 +35,54 @@ struct room_member {
     int user_sock;               // socket of user in room
     struct room_member *next;
 };
+GLIST_DEFINE(member_list, struct room_member, next)
 
 struct room_node {
     char roomname[50];
-    struct room_member *members;
+    struct member_list members;
     struct room_node *next;
 };
+GLIST_DEFINE(room_list, struct room_node, next)
 
 /* ----------------------------
    Globals (defined in list.c)
    ---------------------------- */
-extern struct node *head;           // global user list head
-extern struct room_node *room_head; // global room list head
+extern struct user_list users;   // global user list
+extern struct room_list rooms;   // global room list
 
 /* ----------------------------
-   User list functions (original API)
+   User list functions
    ---------------------------- */
-struct node* insertFirstU(struct node *head, int socket, char *username);
-struct node* findU(struct node *head, char* username);
-struct node* findSocketNode(struct node *head, int socket);
-struct node* removeUserBySocket(struct node *head, int socket);
-void free_all_users(struct node *head);
+/* Inserts a new user at the front; returns NULL if the name is taken. */
+struct node* insertFirstU(struct user_list *l, int socket, char *username);
+struct node* findU(struct user_list *l, char* username);
+struct node* findSocketNode(struct user_list *l, int socket);
+void removeUserBySocket(struct user_list *l, int socket);
+void free_all_users(struct user_list *l);
 
 /* ----------------------------
    Room functions
    ---------------------------- */
-struct room_node* create_room(struct room_node *head, const char *roomname);
-struct room_node* find_room(struct room_node *head, const char *roomname);
-void free_all_rooms(struct room_node *head);
-int add_user_to_room(struct room_node **head, int socket, const char *roomname);
-int remove_user_from_room(struct room_node **head, int socket, const char *roomname);
-void list_rooms_to_buffer(struct room_node *head, char *buf, size_t buflen);
-void list_users_to_buffer(struct node *head, char *buf, size_t buflen);
+/* Returns the room, creating it at the front of the list if needed. */
+struct room_node* create_room(struct room_list *l, const char *roomname);
+struct room_node* find_room(struct room_list *l, const char *roomname);
+void free_all_rooms(struct room_list *l);
+int add_user_to_room(struct room_list *l, int socket, const char *roomname);
+int remove_user_from_room(struct room_list *l, int socket, const char *roomname);
+void list_rooms_to_buffer(struct room_list *l, char *buf, size_t buflen);
+void list_users_to_buffer(struct user_list *l, char *buf, size_t buflen);
 
 /* ----------------------------
    DM management (by socket)
    ---------------------------- */
-int add_dm_connection_socket(struct node *head, int from_sock, int to_sock);
-int remove_dm_connection_socket(struct node *head, int from_sock, int to_sock);
-int is_dm_connected_socket(struct node *head, int from_sock, int to_sock);
+int add_dm_connection_socket(struct user_list *l, int from_sock, int to_sock);
+int remove_dm_connection_socket(struct user_list *l, int from_sock, int to_sock);
+int is_dm_connected_socket(struct user_list *l, int from_sock, int to_sock);
 
 /* ----------------------------
    Utilities
    ---------------------------- */
-void remove_user_from_all_rooms(struct room_node **head, struct node *user);
-void remove_all_dms_for_user(struct node *head, struct node *user);
+void remove_user_from_all_rooms(struct room_list *l, struct node *user);
+void remove_all_dms_for_user(struct user_list *l, struct node *user);
 
 #endif
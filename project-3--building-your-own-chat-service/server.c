@@ -17,8 +17,8 @@ pthread_mutex_t rw_lock = PTHREAD_MUTEX_INITIALIZER;  // read/write lock
 char const *server_MOTD = "Thanks for connecting to the BisonChat Server.\n\nchat>";
 
 /* Global lists (defined in list.c) */
-extern struct node *head;     // user list (list.c uses 'struct node' per your original)
-extern struct room_node *room_head; // room list (we add room structures)
+extern struct user_list users;   // user list (list.c uses 'struct node' per your original)
+extern struct room_list rooms;   // room list (we add room structures)
 
 void init_default_room();
 void free_all_global_resources();
@@ -26,7 +26,7 @@ void free_all_global_resources();
 void init_default_room() {
     // create Lobby at startup
     pthread_mutex_lock(&rw_lock);
-    room_head = create_room(room_head, DEFAULT_ROOM);
+    create_room(&rooms, DEFAULT_ROOM);
     pthread_mutex_unlock(&rw_lock);
 }
 
@@ -120,7 +120,7 @@ void sigintHandler(int sig_num) {
    pthread_mutex_lock(&rw_lock); // block writers/readers
 
    // Close all client sockets and free users
-   struct node *cur = head;
+   struct node *cur = users.head;
    while (cur) {
        printf("Closing socket for user %s (socket %d)\n", cur->username, cur->socket);
        close(cur->socket);
@@ -128,11 +128,8 @@ void sigintHandler(int sig_num) {
    }
 
    // free data structures
-   free_all_rooms(room_head);
-   room_head = NULL;
-
-   free_all_users(head);
-   head = NULL;
+   free_all_rooms(&rooms);
+   free_all_users(&users);
 
    pthread_mutex_unlock(&rw_lock);
 
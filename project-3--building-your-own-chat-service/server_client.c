@@ -1,15 +1,17 @@
 /* server_client.c */
+#include <ctype.h>
 #include "server.h"
 #include "list.h"
 
 extern int numReaders;
 extern pthread_mutex_t mutex;
 extern pthread_mutex_t rw_lock;
+extern char const *server_MOTD;
 
-extern struct node *head;         // user list
-extern struct room_node *room_head; // room list
+extern struct user_list users;   // user list
+extern struct room_list rooms;   // room list
 
-const char *delimiters_local = delimiters; // from server.h
+const char *delimiters_local = DELIMITERS; // from server.h
 
 /* trim whitespace helper */
 char *trimwhitespace(char *str)
@@ -52,9 +54,9 @@ ssize_t safe_send(int socket, const char *buf) {
 /* Check if two users share a room */
 int share_room_users(struct node *a, struct node *b) {
     if (!a || !b) return 0;
-    struct room_node *r = room_head;
+    struct room_node *r = rooms.head;
     while (r) {
-        struct room_member *m = r->members;
+        struct room_member *m = r->members.head;
         int hasa = 0, hasb = 0;
         while (m) {
             if (m->user_sock == a->socket) hasa = 1;
@@ -86,10 +88,9 @@ void *client_receive(void *ptr) {
    snprintf(username, sizeof(username), "guest%d", client);
 
    start_write();
-   head = insertFirstU(head, client, username); // original list.c function
+   insertFirstU(&users, client, username); // original list.c function
    // ensure default room exists and add user to it
-   room_head = create_room(room_head, DEFAULT_ROOM);
-   add_user_to_room(&room_head, client, DEFAULT_ROOM);
+   add_user_to_room(&rooms, client, DEFAULT_ROOM);
    end_write();
 
    while (1) {
@@ -98,11 +99,11 @@ void *client_receive(void *ptr) {
       if (received <= 0) {
          // client disconnected — cleanup
          start_write();
-         struct node *u = findU(head, username);
+         struct node *u = findU(&users, username);
          if (u) {
-             remove_user_from_all_rooms(&room_head, u);
-             remove_all_dms_for_user(head, u);
-             head = removeUserBySocket(head, client);
+             remove_user_from_all_rooms(&rooms, u);
+             remove_all_dms_for_user(&users, u);
+             removeUserBySocket(&users, client);
          }
          end_write();
          close(client);
@@ -128,21 +129,21 @@ void *client_receive(void *ptr) {
       /* ---------- COMMANDS ---------- */
       if (strcmp(arguments[0], "create") == 0 && arguments[1]) {
          start_write();
-         room_head = create_room(room_head, arguments[1]);
+         create_room(&rooms, arguments[1]);
          end_write();
          snprintf(buffer, sizeof(buffer), "Room '%s' created\nchat>", arguments[1]);
          safe_send(client, buffer);
       }
       else if (strcmp(arguments[0], "join") == 0 && arguments[1]) {
          start_write();
-         add_user_to_room(&room_head, client, arguments[1]);
+         add_user_to_room(&rooms, client, arguments[1]);
          end_write();
          snprintf(buffer, sizeof(buffer), "Joined room '%s'\nchat>", arguments[1]);
          safe_send(client, buffer);
       }
       else if (strcmp(arguments[0], "leave") == 0 && arguments[1]) {
          start_write();
-         int r = remove_user_from_room(&room_head, client, arguments[1]);
+         int r = remove_user_from_room(&rooms, client, arguments[1]);
          end_write();
          if (r == 0) snprintf(buffer, sizeof(buffer), "Left room '%s'\nchat>", arguments[1]);
          else snprintf(buffer, sizeof(buffer), "Not a member of room '%s'\nchat>", arguments[1]);
@@ -150,14 +151,14 @@ void *client_receive(void *ptr) {
       }
       else if (strcmp(arguments[0], "connect") == 0 && arguments[1]) {
          start_write();
-         struct node *to = findU(head, arguments[1]);
-         struct node *from = findSocketNode(head, client);
+         struct node *to = findU(&users, arguments[1]);
+         struct node *from = findSocketNode(&users, client);
          if (!to) {
              end_write();
              snprintf(buffer, sizeof(buffer), "User '%s' not found\nchat>", arguments[1]);
              safe_send(client, buffer);
          } else {
-             add_dm_connection_socket(head, from->socket, to->socket);
+             add_dm_connection_socket(&users, from->socket, to->socket);
              end_write();
              snprintf(buffer, sizeof(buffer), "Connected to user '%s'\nchat>", arguments[1]);
              safe_send(client, buffer);
@@ -165,14 +166,14 @@ void *client_receive(void *ptr) {
       }
       else if (strcmp(arguments[0], "disconnect") == 0 && arguments[1]) {
          start_write();
-         struct node *to = findU(head, arguments[1]);
-         struct node *from = findSocketNode(head, client);
+         struct node *to = findU(&users, arguments[1]);
+         struct node *from = findSocketNode(&users, client);
          if (!to) {
              end_write();
              snprintf(buffer, sizeof(buffer), "User '%s' not found\nchat>", arguments[1]);
              safe_send(client, buffer);
          } else {
-             remove_dm_connection_socket(head, from->socket, to->socket);
+             remove_dm_connection_socket(&users, from->socket, to->socket);
              end_write();
              snprintf(buffer, sizeof(buffer), "Disconnected from user '%s'\nchat>", arguments[1]);
              safe_send(client, buffer);
@@ -181,7 +182,7 @@ void *client_receive(void *ptr) {
       else if (strcmp(arguments[0], "rooms") == 0) {
          start_read();
          char out[4096]; out[0]='\0';
-         list_rooms_to_buffer(room_head, out, sizeof(out));
+         list_rooms_to_buffer(&rooms, out, sizeof(out));
          end_read();
          strncat(out, "chat>", sizeof(out)-strlen(out)-1);
          safe_send(client, out);
@@ -189,14 +190,14 @@ void *client_receive(void *ptr) {
       else if (strcmp(arguments[0], "users") == 0) {
          start_read();
          char out[4096]; out[0]='\0';
-         list_users_to_buffer(head, out, sizeof(out));
+         list_users_to_buffer(&users, out, sizeof(out));
          end_read();
          strncat(out, "chat>", sizeof(out)-strlen(out)-1);
          safe_send(client, out);
       }
       else if (strcmp(arguments[0], "login") == 0 && arguments[1]) {
          start_write();
-         struct node *u = findSocketNode(head, client);
+         struct node *u = findSocketNode(&users, client);
          if (u) {
              strncpy(u->username, arguments[1], sizeof(u->username)-1);
              u->username[sizeof(u->username)-1] = '\0';
@@ -212,11 +213,11 @@ void *client_receive(void *ptr) {
       }
       else if (strcmp(arguments[0], "exit") == 0 || strcmp(arguments[0], "logout") == 0) {
          start_write();
-         struct node *u = findSocketNode(head, client);
+         struct node *u = findSocketNode(&users, client);
          if (u) {
-             remove_user_from_all_rooms(&room_head, u);
-             remove_all_dms_for_user(head, u);
-             head = removeUserBySocket(head, client);
+             remove_user_from_all_rooms(&rooms, u);
+             remove_all_dms_for_user(&users, u);
+             removeUserBySocket(&users, client);
          }
          end_write();
          close(client);
@@ -225,7 +226,7 @@ void *client_receive(void *ptr) {
       else {
          /* Not a command — broadcast to shared-room members and DMs */
          start_read();
-         struct node *sender = findSocketNode(head, client);
+         struct node *sender = findSocketNode(&users, client);
          char sendbuf[MAXBUFF+128];
          char trimmed[MAXBUFF];
          strncpy(trimmed, trimwhitespace(sbuffer), sizeof(trimmed)-1);
@@ -233,12 +234,12 @@ void *client_receive(void *ptr) {
          if (sender) snprintf(sendbuf, sizeof(sendbuf), "\n::%s> %s\nchat>", sender->username, trimmed);
          else snprintf(sendbuf, sizeof(sendbuf), "\n::guest%d> %s\nchat>", client, trimmed);
 
-         struct node *iter = head;
+         struct node *iter = users.head;
          while (iter) {
              if (iter->socket != client) {
                  int sendit = 0;
                  // DM check
-                 if (is_dm_connected_socket(head, client, iter->socket)) sendit = 1;
+                 if (is_dm_connected_socket(&users, client, iter->socket)) sendit = 1;
                  // share room check
                  else if (share_room_users(sender, iter)) sendit = 1;
                  if (sendit) safe_send(iter->socket, sendbuf);